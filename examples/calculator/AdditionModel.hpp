@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ColumnKernels.hpp"
 #include "DecimalData.hpp"
 #include "MathOperationDataModel.hpp"
 
@@ -20,6 +21,11 @@ public:
 
     QString name() const override { return QStringLiteral("Addition"); }
 
+    FusableExpression fusableExpression() const override
+    {
+        return expression(FusableExpression::Operation::Add);
+    }
+
 private:
     void compute() override
     {
@@ -29,11 +35,21 @@ private:
         auto n2 = _number2.lock();
 
         if (n1 && n2) {
-            _result = std::make_shared<DecimalData>(n1->number() + n2->number());
+            _result = NodeDataPool<DecimalData>::make(n1->number() + n2->number());
         } else {
             _result.reset();
         }
 
         Q_EMIT dataUpdated(outPortIndex);
     }
+
+    bool computeColumn(ColumnKernels::Operand const &lhs,
+                       ColumnKernels::Operand const &rhs,
+                       double *result,
+                       std::size_t size) const override
+    {
+        ColumnKernels::add(lhs, rhs, result, size);
+
+        return true;
+    }
 };
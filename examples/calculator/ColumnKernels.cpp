@@ -0,0 +1,208 @@
+#include "ColumnKernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CALCULATOR_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+
+namespace {
+
+using ColumnKernels::Operand;
+
+/// Columns allocated by `DecimalColumnData` are aligned, others may be not.
+bool isAligned(double const *values)
+{
+    return (reinterpret_cast<std::uintptr_t>(values) % 16) == 0;
+}
+
+template<bool Aligned>
+struct Column
+{
+    double const *values;
+
+#ifdef CALCULATOR_USE_SSE2
+    __m128d load(std::size_t const i) const
+    {
+        return Aligned ? _mm_load_pd(values + i) : _mm_loadu_pd(values + i);
+    }
+#endif
+
+    double at(std::size_t const i) const { return values[i]; }
+};
+
+/// A number broadcast once instead of expanded to a column.
+struct Scalar
+{
+    explicit Scalar(double const value)
+        : value(value)
+#ifdef CALCULATOR_USE_SSE2
+        , vector(_mm_set1_pd(value))
+#endif
+    {}
+
+    double value;
+
+#ifdef CALCULATOR_USE_SSE2
+    __m128d vector;
+
+    __m128d load(std::size_t) const { return vector; }
+#endif
+
+    double at(std::size_t) const { return value; }
+};
+
+#ifdef CALCULATOR_USE_SSE2
+template<bool Aligned>
+void store(double *result, __m128d const value)
+{
+    if (Aligned)
+        _mm_store_pd(result, value);
+    else
+        _mm_storeu_pd(result, value);
+}
+#endif
+
+template<typename Operation, bool Aligned, typename Lhs, typename Rhs>
+void apply(Lhs const &lhs, Rhs const &rhs, double *result, std::size_t const size)
+{
+    std::size_t i = 0;
+
+#ifdef CALCULATOR_USE_SSE2
+    // Two independent vectors per iteration hide the latency of the
+    // multiplication and division units.
+    for (; i + 4 <= size; i += 4) {
+        store<Aligned>(result + i, Operation::packed(lhs.load(i), rhs.load(i)));
+        store<Aligned>(result + i + 2, Operation::packed(lhs.load(i + 2), rhs.load(i + 2)));
+    }
+#endif
+
+    for (; i < size; ++i) {
+        result[i] = Operation::scalar(lhs.at(i), rhs.at(i));
+    }
+}
+
+/// Picks the loop for the kinds of the operands.
+template<typename Operation, bool Aligned>
+void dispatch(Operand const &lhs, Operand const &rhs, double *result, std::size_t const size)
+{
+    using Values = Column<Aligned>;
+
+    if (lhs.column && rhs.column) {
+        apply<Operation, Aligned>(Values{lhs.column}, Values{rhs.column}, result, size);
+    } else if (lhs.column) {
+        apply<Operation, Aligned>(Values{lhs.column}, Scalar(rhs.value), result, size);
+    } else if (rhs.column) {
+        apply<Operation, Aligned>(Scalar(lhs.value), Values{rhs.column}, result, size);
+    } else {
+        apply<Operation, Aligned>(Scalar(lhs.value), Scalar(rhs.value), result, size);
+    }
+}
+
+/// Uses the aligned loads and stores when all the columns allow them.
+template<typename Operation>
+void dispatch(Operand const &lhs, Operand const &rhs, double *result, std::size_t const size)
+{
+    bool const aligned = isAligned(result) && (!lhs.column || isAligned(lhs.column))
+                         && (!rhs.column || isAligned(rhs.column));
+
+    if (aligned)
+        dispatch<Operation, true>(lhs, rhs, result, size);
+    else
+        dispatch<Operation, false>(lhs, rhs, result, size);
+}
+
+bool containsZero(Operand const &operand, std::size_t const size)
+{
+    if (!operand.column)
+        return operand.value == 0.0;
+
+    std::size_t i = 0;
+
+#ifdef CALCULATOR_USE_SSE2
+    __m128d const zero = _mm_setzero_pd();
+    __m128d found = zero;
+
+    for (; i + 2 <= size; i += 2) {
+        found = _mm_or_pd(found, _mm_cmpeq_pd(_mm_loadu_pd(operand.column + i), zero));
+    }
+
+    if (_mm_movemask_pd(found) != 0)
+        return true;
+#endif
+
+    for (; i < size; ++i) {
+        if (operand.column[i] == 0.0)
+            return true;
+    }
+
+    return false;
+}
+
+struct Addition
+{
+#ifdef CALCULATOR_USE_SSE2
+    static __m128d packed(__m128d const a, __m128d const b) { return _mm_add_pd(a, b); }
+#endif
+
+    static double scalar(double const a, double const b) { return a + b; }
+};
+
+struct Subtraction
+{
+#ifdef CALCULATOR_USE_SSE2
+    static __m128d packed(__m128d const a, __m128d const b) { return _mm_sub_pd(a, b); }
+#endif
+
+    static double scalar(double const a, double const b) { return a - b; }
+};
+
+struct Multiplication
+{
+#ifdef CALCULATOR_USE_SSE2
+    static __m128d packed(__m128d const a, __m128d const b) { return _mm_mul_pd(a, b); }
+#endif
+
+    static double scalar(double const a, double const b) { return a * b; }
+};
+
+struct Division
+{
+#ifdef CALCULATOR_USE_SSE2
+    static __m128d packed(__m128d const a, __m128d const b) { return _mm_div_pd(a, b); }
+#endif
+
+    static double scalar(double const a, double const b) { return a / b; }
+};
+
+} // namespace
+
+namespace ColumnKernels {
+
+void add(Operand const &lhs, Operand const &rhs, double *result, std::size_t size)
+{
+    dispatch<Addition>(lhs, rhs, result, size);
+}
+
+void subtract(Operand const &lhs, Operand const &rhs, double *result, std::size_t size)
+{
+    dispatch<Subtraction>(lhs, rhs, result, size);
+}
+
+void multiply(Operand const &lhs, Operand const &rhs, double *result, std::size_t size)
+{
+    dispatch<Multiplication>(lhs, rhs, result, size);
+}
+
+bool divide(Operand const &lhs, Operand const &rhs, double *result, std::size_t size)
+{
+    if (size > 0 && containsZero(rhs, size))
+        return false;
+
+    dispatch<Division>(lhs, rhs, result, size);
+
+    return true;
+}
+
+} // namespace ColumnKernels
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+/// Element-wise arithmetic over columns of decimals.
+/**
+ * All the kernels compute `result[i] = lhs[i] op rhs[i]` for `size`
+ * elements, an operand given as a single number stands for that number
+ * at every index. The SSE2 variants are used where available and a
+ * portable loop otherwise. Columns aligned on 16 bytes, as the ones of
+ * `DecimalColumnData` are, take the aligned loads and stores.
+ */
+namespace ColumnKernels {
+
+/// One side of an operation, either a column or a single number.
+struct Operand
+{
+    Operand(double const *column)
+        : column(column)
+    {}
+
+    Operand(double const value)
+        : value(value)
+    {}
+
+    /// Null for a single number.
+    double const *column = nullptr;
+
+    double value = 0.0;
+};
+
+void add(Operand const &lhs, Operand const &rhs, double *result, std::size_t size);
+
+void subtract(Operand const &lhs, Operand const &rhs, double *result, std::size_t size);
+
+void multiply(Operand const &lhs, Operand const &rhs, double *result, std::size_t size);
+
+/// Returns false, leaving `result` untouched, when a divisor is zero.
+/**
+ * The quotient is undefined then, the same as for the single numbers of
+ * `DivisionModel`, instead of an infinity or a NaN in some elements.
+ */
+bool divide(Operand const &lhs, Operand const &rhs, double *result, std::size_t size);
+
+} // namespace ColumnKernels
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "DecimalData.hpp"
+
+#include <QtNodes/NodeData>
+#include <QtNodes/SharedBuffer>
+
+#include <QtCore/QtGlobal>
+
+#include <cstddef>
+#include <new>
+
+using QtNodes::BufferData;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+/// Allocates the values on the boundaries suitable for the SIMD kernels.
+template<typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, Alignment> const &)
+    {}
+
+    T *allocate(std::size_t const count)
+    {
+        void *memory = qMallocAligned(count * sizeof(T), Alignment);
+
+        if (!memory)
+            throw std::bad_alloc();
+
+        return static_cast<T *>(memory);
+    }
+
+    void deallocate(T *memory, std::size_t) { qFreeAligned(memory); }
+
+    template<typename U>
+    bool operator==(AlignedAllocator<U, Alignment> const &) const
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(AlignedAllocator<U, Alignment> const &) const
+    {
+        return false;
+    }
+};
+
+/// A whole column of decimals transferred in a single update.
+/**
+ * The values are stored contiguously and aligned for the SIMD kernels of
+ * the math operations. The column travels through the same "decimal"
+ * ports as `DecimalData`, so a graph built for single numbers evaluates
+ * a batch of samples in one propagation wave. Copies of the column share
+ * the values until one of them is modified.
+ */
+class DecimalColumnData : public BufferData<double, AlignedAllocator<double, 64>>
+{
+public:
+    explicit DecimalColumnData(std::size_t const size, double const value = 0.0)
+        : BufferData(Buffer(size, value))
+    {}
+
+    explicit DecimalColumnData(Buffer buffer)
+        : BufferData(std::move(buffer))
+    {}
+
+    NodeDataType type() const override { return DecimalData().type(); }
+
+    std::size_t size() const { return _buffer.size(); }
+
+    double const *data() const { return _buffer.data(); }
+
+    /// Detaches the values shared with other columns first.
+    double *mutableData() { return _buffer.mutableData(); }
+
+    double operator[](std::size_t const index) const { return _buffer[index]; }
+};
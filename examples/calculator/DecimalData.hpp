@@ -1,8 +1,13 @@
 #pragma once
 
 #include <QtNodes/NodeData>
+#include <QtNodes/NodeDataPool>
+
+#include <cstdint>
+#include <cstring>
 
 using QtNodes::NodeData;
+using QtNodes::NodeDataPool;
 using QtNodes::NodeDataType;
 
 /// The class can potentially incapsulate any user data which
@@ -22,6 +27,29 @@ public:
 
     double number() const { return _number; }
 
+    bool equals(NodeData const &other) const override
+    {
+        auto decimal = dynamic_cast<DecimalData const *>(&other);
+
+        return decimal && decimal->_number == _number;
+    }
+
+    std::uint64_t fingerprint() const override
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &_number, sizeof(bits));
+
+        // A bijective mix with a constant standing for the type. The one
+        // number mapped onto zero is simply not fingerprinted.
+        return (bits ^ 0x9e3779b97f4a7c15ull) * 0xbf58476d1ce4e5b9ull;
+    }
+
+    bool scalarValue(double &value) const override
+    {
+        value = _number;
+        return true;
+    }
+
     QString numberAsText() const { return QString::number(_number, 'f'); }
 
 private:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ColumnKernels.hpp"
 #include "DecimalData.hpp"
 #include "MathOperationDataModel.hpp"
 
@@ -47,6 +48,11 @@ public:
 
     QString name() const override { return QStringLiteral("Division"); }
 
+    FusableExpression fusableExpression() const override
+    {
+        return expression(FusableExpression::Operation::Divide);
+    }
+
 private:
     void compute() override
     {
@@ -62,7 +68,7 @@ private:
         } else if (n1 && n2) {
             //modelValidationState = NodeValidationState::Valid;
             //modelValidationError = QString();
-            _result = std::make_shared<DecimalData>(n1->number() / n2->number());
+            _result = NodeDataPool<DecimalData>::make(n1->number() / n2->number());
         } else {
             //modelValidationState = NodeValidationState::Warning;
             //modelValidationError = QStringLiteral("Missing or incorrect inputs");
@@ -71,4 +77,12 @@ private:
 
         Q_EMIT dataUpdated(outPortIndex);
     }
+
+    bool computeColumn(ColumnKernels::Operand const &lhs,
+                       ColumnKernels::Operand const &rhs,
+                       double *result,
+                       std::size_t size) const override
+    {
+        return ColumnKernels::divide(lhs, rhs, result, size);
+    }
 };
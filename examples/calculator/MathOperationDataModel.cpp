@@ -1,5 +1,6 @@
 #include "MathOperationDataModel.hpp"
 
+#include "DecimalColumnData.hpp"
 #include "DecimalData.hpp"
 
 unsigned int MathOperationDataModel::nPorts(PortType portType) const
@@ -21,12 +22,59 @@ NodeDataType MathOperationDataModel::dataType(PortType, PortIndex) const
 
 std::shared_ptr<NodeData> MathOperationDataModel::outData(PortIndex)
 {
+    if (_columnResult)
+        return _columnResult;
+
     return std::static_pointer_cast<NodeData>(_result);
 }
 
 void MathOperationDataModel::setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+{
+    storeInData(data, portIndex);
+
+    evaluate();
+}
+
+void MathOperationDataModel::setChangedInData(PortDataList const &inputs)
+{
+    // Both operands may change in the same wave, the result is computed once.
+    for (auto const &input : inputs) {
+        storeInData(input.second, input.first);
+    }
+
+    evaluate();
+}
+
+void MathOperationDataModel::setComputeResult(PortDataList const &outputs)
+{
+    // Results of the fused kernels are single numbers.
+    for (auto const &output : outputs) {
+        _result = std::dynamic_pointer_cast<DecimalData>(output.second);
+        _columnResult.reset();
+    }
+}
+
+void MathOperationDataModel::inputsInvalidated()
+{
+    _result.reset();
+    _columnResult.reset();
+}
+
+FusableExpression MathOperationDataModel::expression(FusableExpression::Operation const operation)
+{
+    FusableExpression result;
+
+    result.operation = operation;
+    result.makeData = [](double const value) { return NodeDataPool<DecimalData>::make(value); };
+
+    return result;
+}
+
+void MathOperationDataModel::storeInData(std::shared_ptr<NodeData> const &data,
+                                         PortIndex portIndex)
 {
     auto numberData = std::dynamic_pointer_cast<DecimalData>(data);
+    auto columnData = std::dynamic_pointer_cast<DecimalColumnData>(data);
 
     if (!data) {
         Q_EMIT dataInvalidated(0);
@@ -34,9 +82,64 @@ void MathOperationDataModel::setInData(std::shared_ptr<NodeData> data, PortIndex
 
     if (portIndex == 0) {
         _number1 = numberData;
+        _column1 = columnData;
     } else {
         _number2 = numberData;
+        _column2 = columnData;
+    }
+}
+
+void MathOperationDataModel::evaluate()
+{
+    if (_column1.expired() && _column2.expired()) {
+        _columnResult.reset();
+
+        compute();
+    } else {
+        _result.reset();
+
+        computeColumns();
+    }
+}
+
+void MathOperationDataModel::computeColumns()
+{
+    PortIndex const outPortIndex = 0;
+
+    auto c1 = _column1.lock();
+    auto c2 = _column2.lock();
+
+    std::size_t const size = c1 ? c1->size() : c2->size();
+
+    // Fails when the input is missing or a column of another length.
+    auto toOperand = [size](std::shared_ptr<DecimalColumnData> const &column,
+                            std::weak_ptr<DecimalData> const &number,
+                            ColumnKernels::Operand &operand) {
+        if (column) {
+            operand = ColumnKernels::Operand(column->data());
+
+            return column->size() == size;
+        }
+
+        auto n = number.lock();
+
+        if (n)
+            operand = ColumnKernels::Operand(n->number());
+
+        return n != nullptr;
+    };
+
+    ColumnKernels::Operand lhs(0.0);
+    ColumnKernels::Operand rhs(0.0);
+
+    if (toOperand(c1, _number1, lhs) && toOperand(c2, _number2, rhs)) {
+        _columnResult = std::make_shared<DecimalColumnData>(size);
+
+        if (!computeColumn(lhs, rhs, _columnResult->mutableData(), size))
+            _columnResult.reset();
+    } else {
+        _columnResult.reset();
     }
 
-    compute();
+    Q_EMIT dataUpdated(outPortIndex);
 }
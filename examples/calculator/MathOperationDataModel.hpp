@@ -1,15 +1,20 @@
 #pragma once
 
+#include "ColumnKernels.hpp"
+
 #include <QtNodes/NodeDelegateModel>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtWidgets/QLabel>
 
+#include <cstddef>
 #include <iostream>
 
+class DecimalColumnData;
 class DecimalData;
 
+using QtNodes::FusableExpression;
 using QtNodes::NodeData;
 using QtNodes::NodeDataType;
 using QtNodes::NodeDelegateModel;
@@ -34,14 +39,49 @@ public:
 
     void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
 
+    void setChangedInData(PortDataList const &inputs) override;
+
+    void setComputeResult(PortDataList const &outputs) override;
+
+    void inputsInvalidated() override;
+
     QWidget *embeddedWidget() override { return nullptr; }
 
 protected:
     virtual void compute() = 0;
 
+    /// Builds the description of the operation for the fused kernels.
+    static FusableExpression expression(FusableExpression::Operation const operation);
+
+    /// Batch variant of `compute()`, evaluates the operation over whole columns.
+    /**
+     * Returns false when the operands have no result, the output is then
+     * reset as `compute()` does for single numbers.
+     */
+    virtual bool computeColumn(ColumnKernels::Operand const &lhs,
+                               ColumnKernels::Operand const &rhs,
+                               double *result,
+                               std::size_t size) const
+        = 0;
+
+private:
+    void storeInData(std::shared_ptr<NodeData> const &data, PortIndex portIndex);
+
+    /// Dispatches to `compute()` or, when a column arrived, to `computeColumns()`.
+    void evaluate();
+
+    /// A single number on the other input applies to every element of the column.
+    void computeColumns();
+
 protected:
     std::weak_ptr<DecimalData> _number1;
     std::weak_ptr<DecimalData> _number2;
 
     std::shared_ptr<DecimalData> _result;
+
+private:
+    std::weak_ptr<DecimalColumnData> _column1;
+    std::weak_ptr<DecimalColumnData> _column2;
+
+    std::shared_ptr<DecimalColumnData> _columnResult;
 };
@@ -7,6 +7,7 @@
 
 #include "MathOperationDataModel.hpp"
 
+#include "ColumnKernels.hpp"
 #include "DecimalData.hpp"
 
 /// The model dictates the number of inputs and outputs for the Node.
@@ -21,6 +22,11 @@ public:
 
     QString name() const override { return QStringLiteral("Multiplication"); }
 
+    FusableExpression fusableExpression() const override
+    {
+        return expression(FusableExpression::Operation::Multiply);
+    }
+
 private:
     void compute() override
     {
@@ -32,7 +38,7 @@ private:
         if (n1 && n2) {
             //modelValidationState = NodeValidationState::Valid;
             //modelValidationError = QString();
-            _result = std::make_shared<DecimalData>(n1->number() * n2->number());
+            _result = NodeDataPool<DecimalData>::make(n1->number() * n2->number());
         } else {
             //modelValidationState = NodeValidationState::Warning;
             //modelValidationError = QStringLiteral("Missing or incorrect inputs");
@@ -41,4 +47,14 @@ private:
 
         Q_EMIT dataUpdated(outPortIndex);
     }
+
+    bool computeColumn(ColumnKernels::Operand const &lhs,
+                       ColumnKernels::Operand const &rhs,
+                       double *result,
+                       std::size_t size) const override
+    {
+        ColumnKernels::multiply(lhs, rhs, result, size);
+
+        return true;
+    }
 };
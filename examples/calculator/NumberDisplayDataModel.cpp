@@ -52,6 +52,16 @@ void NumberDisplayDataModel::setInData(std::shared_ptr<NodeData> data, PortIndex
     _label->adjustSize();
 }
 
+void NumberDisplayDataModel::inputsInvalidated()
+{
+    _numberData.reset();
+
+    if (_label) {
+        _label->clear();
+        _label->adjustSize();
+    }
+}
+
 QWidget *NumberDisplayDataModel::embeddedWidget()
 {
     if (!_label) {
@@ -43,6 +43,8 @@ public:
 
     void setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
 
+    void inputsInvalidated() override;
+
     QWidget *embeddedWidget() override;
 
     double number() const;
@@ -8,7 +8,7 @@
 
 NumberSourceDataModel::NumberSourceDataModel()
     : _lineEdit{nullptr}
-    , _number(std::make_shared<DecimalData>(0.0))
+    , _number(NodeDataPool<DecimalData>::make(0.0))
 {}
 
 QJsonObject NumberSourceDataModel::save() const
@@ -30,7 +30,7 @@ void NumberSourceDataModel::load(QJsonObject const &p)
         bool ok;
         double d = strNum.toDouble(&ok);
         if (ok) {
-            _number = std::make_shared<DecimalData>(d);
+            _number = NodeDataPool<DecimalData>::make(d);
 
             if (_lineEdit)
                 _lineEdit->setText(strNum);
@@ -64,7 +64,7 @@ void NumberSourceDataModel::onTextEdited(QString const &str)
     double number = str.toDouble(&ok);
 
     if (ok) {
-        _number = std::make_shared<DecimalData>(number);
+        _number = NodeDataPool<DecimalData>::make(number);
 
         Q_EMIT dataUpdated(0);
 
@@ -101,7 +101,7 @@ QWidget *NumberSourceDataModel::embeddedWidget()
 
 void NumberSourceDataModel::setNumber(double n)
 {
-    _number = std::make_shared<DecimalData>(n);
+    _number = NodeDataPool<DecimalData>::make(n);
 
     Q_EMIT dataUpdated(0);
 
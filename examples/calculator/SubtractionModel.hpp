@@ -7,6 +7,7 @@
 
 #include "MathOperationDataModel.hpp"
 
+#include "ColumnKernels.hpp"
 #include "DecimalData.hpp"
 
 /// The model dictates the number of inputs and outputs for the Node.
@@ -48,6 +49,11 @@ public:
 
     QString name() const override { return QStringLiteral("Subtraction"); }
 
+    FusableExpression fusableExpression() const override
+    {
+        return expression(FusableExpression::Operation::Subtract);
+    }
+
 private:
     void compute() override
     {
@@ -57,11 +63,21 @@ private:
         auto n2 = _number2.lock();
 
         if (n1 && n2) {
-            _result = std::make_shared<DecimalData>(n1->number() - n2->number());
+            _result = NodeDataPool<DecimalData>::make(n1->number() - n2->number());
         } else {
             _result.reset();
         }
 
         Q_EMIT dataUpdated(outPortIndex);
     }
+
+    bool computeColumn(ColumnKernels::Operand const &lhs,
+                       ColumnKernels::Operand const &rhs,
+                       double *result,
+                       std::size_t size) const override
+    {
+        ColumnKernels::subtract(lhs, rhs, result, size);
+
+        return true;
+    }
 };
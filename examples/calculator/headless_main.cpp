@@ -1,4 +1,5 @@
 #include "AdditionModel.hpp"
+#include "DecimalColumnData.hpp"
 #include "DivisionModel.hpp"
 #include "MultiplicationModel.hpp"
 #include "NumberDisplayDataModel.hpp"
@@ -108,6 +109,9 @@ int main(int argc, char *argv[])
     // Here we create a graph model without attaching to any view or scene.
     DataFlowGraphModel dataFlowGraphModel(registry);
 
+    // The operations compute once per update, whatever number of operands changed.
+    dataFlowGraphModel.setPropagationMode(DataFlowGraphModel::PropagationMode::Topological);
+
     // Alternatively you can create the graph by yourself with the functions
     // `DataFlowGraphModel::addNode` and `DataFlowGraphModel::addConnection` and
     // use the obtained `NodeId` to fetch the `NodeDelegateModel`s
@@ -133,5 +137,54 @@ int main(int argc, char *argv[])
 
     qInfo() << "Result of the addiion operation: "
             << dataFlowGraphModel.delegateModel<NumberDisplayDataModel>(nodeResult)->number();
+
+    // For many evaluations of an unchanged graph the model is flattened into
+    // a plan which is executed without going through the signal machinery.
+    NodeId const nodeAddition = 1;
+
+    QtNodes::ExecutionPlan const plan = dataFlowGraphModel.compile();
+
+    auto const sourceSlot = plan.outputSlot(nodeSource, 0);
+    auto const additionSlot = plan.outputSlot(nodeAddition, 0);
+
+    QtNodes::ExecutionPlan::Slots slots;
+
+    qInfo() << "========================================";
+    for (double number : {1., 2., 3.}) {
+        auto input = NodeDataPool<DecimalData>::make(number);
+
+        dataFlowGraphModel.execute(plan, {{sourceSlot, input}}, slots);
+
+        auto result = std::dynamic_pointer_cast<DecimalData>(slots[additionSlot]);
+
+        qInfo() << "Compiled plan:" << number << "+" << number << "=" << result->number();
+    }
+
+    // A column of samples travels through the same ports and is processed
+    // by the operators in a single invocation.
+    std::size_t const sampleCount = 1000000;
+
+    auto samples = std::make_shared<DecimalColumnData>(sampleCount);
+
+    double *values = samples->mutableData();
+
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        values[i] = static_cast<double>(i);
+    }
+
+    dataFlowGraphModel.execute(plan, {{sourceSlot, samples}}, slots);
+
+    auto column = std::dynamic_pointer_cast<DecimalColumnData>(slots[additionSlot]);
+
+    qInfo() << "========================================";
+    qInfo() << "Compiled plan over" << column->size() << "samples, the last one:"
+            << (*column)[sampleCount - 1];
+
+    // The decimals released by the previous evaluations are recycled.
+    qInfo() << "========================================";
+    qInfo() << "Decimal pool hit rate:" << NodeDataPool<DecimalData>::hitRate() << "("
+            << NodeDataPool<DecimalData>::hits() << "hits," << NodeDataPool<DecimalData>::misses()
+            << "misses)";
+
     return 0;
 }
@@ -88,6 +88,9 @@ int main(int argc, char *argv[])
 
     DataFlowGraphModel dataFlowGraphModel(registry);
 
+    // The operations compute once per update, whatever number of operands changed.
+    dataFlowGraphModel.setPropagationMode(DataFlowGraphModel::PropagationMode::Topological);
+
     l->addWidget(menuBar);
     auto scene = new DataFlowGraphicsScene(dataFlowGraphModel, &mainWidget);
 
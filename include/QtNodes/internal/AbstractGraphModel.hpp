@@ -4,6 +4,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QObject>
@@ -11,6 +12,11 @@
 
 #include "ConnectionIdHash.hpp"
 #include "Definitions.hpp"
+#include "FunctionRef.hpp"
+#include "NodeData.hpp"
+#include "NodeStyle.hpp"
+
+class QWidget;
 
 namespace QtNodes {
 
@@ -27,6 +33,11 @@ namespace QtNodes {
 class NODE_EDITOR_PUBLIC AbstractGraphModel : public QObject
 {
     Q_OBJECT
+public:
+    using NodeVisitor = FunctionRef<void(NodeId const)>;
+
+    using ConnectionVisitor = FunctionRef<void(ConnectionId const &)>;
+
 public:
     /// Generates a new unique NodeId.
     virtual NodeId newNodeId() = 0;
@@ -55,6 +66,42 @@ public:
                                                          PortIndex index) const
         = 0;
 
+    /// Calls `visitor` for every node in the graph.
+    /**
+   * Unlike `allNodeIds()` the function does not build a temporary set.
+   * The default implementation falls back to `allNodeIds()`, models
+   * having their own node storage should override it.
+   *
+   * The visitor must not modify the graph.
+   */
+    virtual void forEachNode(NodeVisitor const visitor) const;
+
+    /// Calls `visitor` for every input and output connection of `nodeId`.
+    /**
+   * Allocation-free counterpart of `allConnectionIds()`. The default
+   * implementation falls back to `allConnectionIds()`.
+   *
+   * The visitor must not modify the graph.
+   */
+    virtual void forEachConnection(NodeId const nodeId, ConnectionVisitor const visitor) const;
+
+    /// Calls `visitor` for every connection attached to the given port.
+    /**
+   * Allocation-free counterpart of `connections()`. The default
+   * implementation falls back to `connections()`.
+   *
+   * The visitor must not modify the graph.
+   */
+    virtual void forEachConnection(NodeId const nodeId,
+                                   PortType const portType,
+                                   PortIndex const portIndex,
+                                   ConnectionVisitor const visitor) const;
+
+    /// Number of connections attached to the given port.
+    virtual std::size_t connectionCount(NodeId const nodeId,
+                                        PortType const portType,
+                                        PortIndex const portIndex) const;
+
     /// Checks if two nodes with the given `connectionId` are connected.
     virtual bool connectionExists(ConnectionId const connectionId) const = 0;
 
@@ -111,6 +158,64 @@ public:
         return nodeData(nodeId, role).value<T>();
     }
 
+    /// @name Typed accessors
+    /**
+   * Shortcuts for the most frequently requested roles. Geometry and
+   * painter classes call them for every port on every repaint, so the
+   * functions avoid boxing the values into a `QVariant`.
+   *
+   * The default implementations forward to `nodeData` and `portData`,
+   * a model can override them to read its storage directly.
+   */
+    ///@{
+
+    /// `NodeRole::Position`
+    virtual QPointF nodePosition(NodeId const nodeId) const;
+
+    /// `NodeRole::Size`
+    virtual QSize nodeSize(NodeId const nodeId) const;
+
+    /// `NodeRole::CaptionVisible`
+    virtual bool nodeCaptionVisible(NodeId const nodeId) const;
+
+    /// `NodeRole::Caption`
+    virtual QString nodeCaption(NodeId const nodeId) const;
+
+    /// `NodeRole::Widget`
+    virtual QWidget *nodeWidget(NodeId const nodeId) const;
+
+    /// `NodeRole::Style`, the default implementation parses the JSON object.
+    /**
+   * The scene reads the style once per node and again on
+   * `nodeStyleUpdated`, models changing the style emit that signal.
+   */
+    virtual NodeStyle nodeStyle(NodeId const nodeId) const;
+
+    /// `NodeRole::InPortCount` or `NodeRole::OutPortCount`
+    virtual PortCount portCount(NodeId const nodeId, PortType const portType) const;
+
+    /// `PortRole::DataType`
+    virtual NodeDataType portDataType(NodeId const nodeId,
+                                      PortType const portType,
+                                      PortIndex const portIndex) const;
+
+    /// `PortRole::CaptionVisible`
+    virtual bool portCaptionVisible(NodeId const nodeId,
+                                    PortType const portType,
+                                    PortIndex const portIndex) const;
+
+    /// `PortRole::Caption`
+    virtual QString portCaption(NodeId const nodeId,
+                                PortType const portType,
+                                PortIndex const portIndex) const;
+
+    /// `PortRole::ConnectionPolicyRole`
+    virtual ConnectionPolicy portConnectionPolicy(NodeId const nodeId,
+                                                  PortType const portType,
+                                                  PortIndex const portIndex) const;
+
+    ///@}
+
     virtual NodeFlags nodeFlags(NodeId nodeId) const
     {
         Q_UNUSED(nodeId);
@@ -225,6 +330,43 @@ public:
    */
     void portsInserted();
 
+public:
+    /// Starts a batch of graph modifications.
+    /**
+   * While a batch is open the creation and deletion notifications are
+   * queued instead of being emitted one by one. The calls can be nested,
+   * the queued changes are delivered by the outermost `endBatch()`.
+   *
+   * @see GraphModelBatch for an RAII helper.
+   */
+    void beginBatch();
+
+    /**
+   * Closes the batch. When the outermost batch is closed, the queued
+   * changes are emitted as `connectionsDeleted`, `nodesDeleted`,
+   * `nodesCreated` and `connectionsCreated`, in this order.
+   */
+    void endBatch();
+
+    bool batchInProgress() const { return _batchDepth > 0; }
+
+protected:
+    /**
+   * Derived models call these functions instead of emitting the single
+   * item signals directly. Outside of a batch the corresponding signal is
+   * emitted immediately. Inside a batch the change is queued; items
+   * created and deleted within the same batch are never reported.
+   */
+    ///@{
+    void notifyNodeCreated(NodeId const nodeId);
+
+    void notifyNodeDeleted(NodeId const nodeId);
+
+    void notifyConnectionCreated(ConnectionId const connectionId);
+
+    void notifyConnectionDeleted(ConnectionId const connectionId);
+    ///@}
+
 Q_SIGNALS:
     void connectionCreated(ConnectionId const connectionId);
 
@@ -240,10 +382,70 @@ Q_SIGNALS:
 
     void nodePositionUpdated(NodeId const nodeId);
 
+    /// The value returned by `nodeStyle` changed.
+    void nodeStyleUpdated(NodeId const nodeId);
+
     void modelReset();
 
+    /// Bulk counterpart of `nodeCreated`, emitted when a batch is closed.
+    void nodesCreated(std::vector<NodeId> const &nodeIds);
+
+    /// Bulk counterpart of `nodeDeleted`, emitted when a batch is closed.
+    void nodesDeleted(std::vector<NodeId> const &nodeIds);
+
+    /// Bulk counterpart of `connectionCreated`, emitted when a batch is closed.
+    void connectionsCreated(std::vector<ConnectionId> const &connectionIds);
+
+    /// Bulk counterpart of `connectionDeleted`, emitted when a batch is closed.
+    void connectionsDeleted(std::vector<ConnectionId> const &connectionIds);
+
 private:
     std::vector<ConnectionId> _shiftedByDynamicPortsConnections;
+
+    unsigned int _batchDepth = 0;
+
+    /// Creation order of the queued items, may hold items deleted since.
+    std::vector<NodeId> _batchCreatedNodes;
+
+    /// Queued items still alive, looked up by the deletion notifications.
+    std::unordered_set<NodeId> _batchPendingNodes;
+
+    std::vector<NodeId> _batchDeletedNodes;
+
+    std::vector<ConnectionId> _batchCreatedConnections;
+
+    std::unordered_set<ConnectionId> _batchPendingConnections;
+
+    std::vector<ConnectionId> _batchDeletedConnections;
+};
+
+/**
+ * Opens a batch on the given model for the lifetime of the object.
+ *
+ * ```
+ * {
+ *   GraphModelBatch batch(graphModel);
+ *   // load or paste many nodes here
+ * } // the scene receives the bulk signals here
+ * ```
+ */
+class GraphModelBatch
+{
+public:
+    explicit GraphModelBatch(AbstractGraphModel &graphModel)
+        : _graphModel(graphModel)
+    {
+        _graphModel.beginBatch();
+    }
+
+    ~GraphModelBatch() { _graphModel.endBatch(); }
+
+    GraphModelBatch(GraphModelBatch const &) = delete;
+
+    GraphModelBatch &operator=(GraphModelBatch const &) = delete;
+
+private:
+    AbstractGraphModel &_graphModel;
 };
 
 } // namespace QtNodes
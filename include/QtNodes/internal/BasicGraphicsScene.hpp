@@ -8,6 +8,7 @@
 #include <memory>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "AbstractGraphModel.hpp"
 #include "AbstractNodeGeometry.hpp"
@@ -152,10 +153,27 @@ public Q_SLOTS:
 
     void onNodeCreated(NodeId const nodeId);
 
+    /// Slots receiving the changes accumulated by a model batch.
+    /**
+   * All graphics objects are created or removed in one pass and the
+   * `modified` signal is emitted once per batch.
+   */
+    ///@{
+    void onNodesCreated(std::vector<NodeId> const &nodeIds);
+
+    void onNodesDeleted(std::vector<NodeId> const &nodeIds);
+
+    void onConnectionsCreated(std::vector<ConnectionId> const &connectionIds);
+
+    void onConnectionsDeleted(std::vector<ConnectionId> const &connectionIds);
+    ///@}
+
     void onNodePositionUpdated(NodeId const nodeId);
 
     void onNodeUpdated(NodeId const nodeId);
 
+    void onNodeStyleUpdated(NodeId const nodeId);
+
     void onNodeClicked(NodeId const nodeId);
 
     void onModelReset();
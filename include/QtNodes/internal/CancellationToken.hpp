@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace QtNodes {
+
+/**
+ * Shared flag telling an asynchronous computation that its result is no
+ * longer needed.
+ *
+ * Copies of a token observe the same flag. DataFlowGraphModel cancels the
+ * token of a running computation as soon as newer inputs for the node
+ * arrive; long computations are expected to poll `isCancelled()` and
+ * return early.
+ */
+class CancellationToken
+{
+public:
+    CancellationToken()
+        : _cancelled(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    void cancel() { _cancelled->store(true, std::memory_order_relaxed); }
+
+    bool isCancelled() const { return _cancelled->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+};
+
+} // namespace QtNodes
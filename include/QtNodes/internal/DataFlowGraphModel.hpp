@@ -2,15 +2,31 @@
 
 #include "AbstractGraphModel.hpp"
 #include "ConnectionIdUtils.hpp"
+#include "ExecutionPlan.hpp"
 #include "NodeDelegateModelRegistry.hpp"
+#include "NodeSlotMap.hpp"
+#include "OutputCache.hpp"
+#include "ReachabilityCache.hpp"
 #include "Serializable.hpp"
 #include "StyleCollection.hpp"
+#include "TopologicalOrder.hpp"
+#include "WorkStealingThreadPool.hpp"
 
 #include "Export.hpp"
 
 #include <QJsonObject>
+#include <QtCore/QTimer>
 
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <unordered_set>
+#include <vector>
 
 namespace QtNodes {
 
@@ -25,6 +41,66 @@ public:
         QPointF pos;
     };
 
+    /// All the per-node data stored in one contiguous record.
+    struct NodeRecord
+    {
+        std::unique_ptr<NodeDelegateModel> model;
+        NodeGeometryData geometry;
+        NodeFlags flags;
+
+        /// Interned port data types, @see NodeDelegateModelRegistry::dataTypeId.
+        std::vector<DataTypeId> inTypes;
+        std::vector<DataTypeId> outTypes;
+
+        /// The port data types as reported by the delegate, read by the painters.
+        std::vector<NodeDataType> inDataTypes;
+        std::vector<NodeDataType> outDataTypes;
+
+        /// Latest inputs delivered by the topological propagation.
+        std::vector<std::shared_ptr<NodeData>> inData;
+
+        /// Latest outputs sent downstream, @see outputChanged.
+        std::vector<std::shared_ptr<NodeData>> outData;
+
+        /// Revisions of `outData` when they were sent, @see NodeData::revision.
+        std::vector<std::uint64_t> outRevisions;
+
+        /// The delegate was handed outputs without the inputs behind them,
+        /// e.g. from the memoization, @see completeInputs.
+        bool staleInputs = false;
+    };
+
+    /// Defines how the new output data travels downstream.
+    enum class PropagationMode {
+        /// Every output update is pushed through the connections immediately
+        /// and depth-first. A node with several changed inputs computes once
+        /// per input. This is the default and the behavior of the previous
+        /// versions.
+        Cascade,
+
+        /// Changed inputs are staged and the affected nodes are evaluated in
+        /// topological order, each of them exactly once per update wave.
+        /// Required by the worker threads, the memoization and coalescing.
+        /// Opt-in through `setPropagationMode`, delegates relying on the
+        /// per-input calls of `Cascade` keep working unchanged.
+        Topological,
+
+        /// Same as `Topological`, but only the nodes whose outputs are
+        /// demanded are evaluated. Demand comes from observed nodes, nodes
+        /// without outputs and explicit `evaluate()` calls; the other nodes
+        /// keep their changed inputs pending.
+        Lazy,
+
+        /// Every connection carries a bounded queue and each output update
+        /// is enqueued instead of replacing the previous one. A node fires
+        /// once per queued update and different nodes fire concurrently
+        /// when they run on the worker threads, so consecutive updates of
+        /// a source flow through the graph in pipeline fashion. A node
+        /// whose outgoing queue is full does not fire, which propagates
+        /// the backpressure up to the sources.
+        Streaming
+    };
+
 public:
     DataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry);
 
@@ -39,18 +115,62 @@ public:
                                                  PortType portType,
                                                  PortIndex portIndex) const override;
 
+    void forEachNode(NodeVisitor const visitor) const override;
+
+    void forEachConnection(NodeId const nodeId, ConnectionVisitor const visitor) const override;
+
+    void forEachConnection(NodeId const nodeId,
+                           PortType const portType,
+                           PortIndex const portIndex,
+                           ConnectionVisitor const visitor) const override;
+
+    std::size_t connectionCount(NodeId const nodeId,
+                                PortType const portType,
+                                PortIndex const portIndex) const override;
+
     bool connectionExists(ConnectionId const connectionId) const override;
 
     NodeId addNode(QString const nodeType) override;
 
     bool connectionPossible(ConnectionId const connectionId) const override;
 
+    /// Connections closing a cycle are refused, @see connectionRejected.
     void addConnection(ConnectionId const connectionId) override;
 
     bool nodeExists(NodeId const nodeId) const override;
 
     QVariant nodeData(NodeId nodeId, NodeRole role) const override;
 
+    QPointF nodePosition(NodeId const nodeId) const override;
+
+    QSize nodeSize(NodeId const nodeId) const override;
+
+    bool nodeCaptionVisible(NodeId const nodeId) const override;
+
+    QString nodeCaption(NodeId const nodeId) const override;
+
+    QWidget *nodeWidget(NodeId const nodeId) const override;
+
+    NodeStyle nodeStyle(NodeId const nodeId) const override;
+
+    PortCount portCount(NodeId const nodeId, PortType const portType) const override;
+
+    NodeDataType portDataType(NodeId const nodeId,
+                              PortType const portType,
+                              PortIndex const portIndex) const override;
+
+    bool portCaptionVisible(NodeId const nodeId,
+                            PortType const portType,
+                            PortIndex const portIndex) const override;
+
+    QString portCaption(NodeId const nodeId,
+                        PortType const portType,
+                        PortIndex const portIndex) const override;
+
+    ConnectionPolicy portConnectionPolicy(NodeId const nodeId,
+                                          PortType const portType,
+                                          PortIndex const portIndex) const override;
+
     NodeFlags nodeFlags(NodeId nodeId) const override;
 
     bool setNodeData(NodeId nodeId, NodeRole role, QVariant value) override;
@@ -78,6 +198,140 @@ public:
 
     void load(QJsonObject const &json) override;
 
+    /// @returns the nodes feeding `nodeId` through at most `depth` connections.
+    /**
+   * Results are cached and only recomputed after the connections of the
+   * affected region change, so the call is cheap enough for hover effects.
+   */
+    std::unordered_set<NodeId> upstreamOf(
+        NodeId const nodeId, unsigned int const depth = ReachabilityCache::UnlimitedDepth) const;
+
+    /// @returns the nodes fed by `nodeId` through at most `depth` connections.
+    std::unordered_set<NodeId> downstreamOf(
+        NodeId const nodeId, unsigned int const depth = ReachabilityCache::UnlimitedDepth) const;
+
+    /// Checks whether data produced by `from` eventually arrives at `to`.
+    bool reaches(NodeId const from, NodeId const to) const;
+
+    PropagationMode propagationMode() const { return _propagationMode; }
+
+    void setPropagationMode(PropagationMode const mode);
+
+    unsigned int workerThreadCount() const { return _workerThreadCount; }
+
+    /// Evaluates thread-safe nodes on a pool of `count` worker threads.
+    /**
+   * Worker threads are only used by the topological propagation. A node
+   * is handed over to a worker when its delegate reports the `AnyThread`
+   * `NodeDelegateModel::affinity()` and no computation running or waiting
+   * upstream can still change its inputs. Independent branches of the
+   * graph are therefore evaluated in parallel while every node still
+   * computes once per wave. Downstream `AnyThread` nodes fed only by the
+   * node are evaluated on the same worker right after it.
+   *
+   * A zero `count` (the default) keeps the thread-safe nodes on the GUI
+   * thread. Asynchronous computations created by
+   * `NodeDelegateModel::computeTask` always run on the pool, which is then
+   * sized after the number of hardware threads. `IoThread` nodes always
+   * run on their own dedicated thread.
+   */
+    void setWorkerThreadCount(unsigned int const count);
+
+    int coalescingInterval() const { return _coalescingInterval; }
+
+    /// Coalesces the output updates of the sources.
+    /**
+   * Output updates emitted outside of a propagation wave, typically by
+   * source nodes driven by sliders or line edits, are collected for
+   * `msec` milliseconds and then propagated at once. Repeated updates of
+   * the same output port within the interval deliver only the latest
+   * data. A zero interval coalesces the updates of one event-loop
+   * iteration. A negative interval (the default) propagates every update
+   * immediately.
+   *
+   * Coalescing applies to the topological propagation modes.
+   */
+    void setCoalescingInterval(int const msec);
+
+    /// Propagates the coalesced updates right away.
+    void flushCoalescedUpdates();
+
+    std::size_t streamQueueCapacity() const { return _streamQueueCapacity; }
+
+    /// Bounds the connection queues of the `Streaming` mode, at least 1.
+    void setStreamQueueCapacity(std::size_t const capacity);
+
+    /// Number of updates waiting in the queue of the connection.
+    std::size_t queueDepth(ConnectionId const connectionId) const;
+
+    /// Checks whether a full queue downstream holds the node back.
+    /// @see NodeDelegateModel::backpressureChanged
+    bool isThrottled(NodeId const nodeId) const { return _throttledNodes.count(nodeId) > 0; }
+
+    std::size_t memoizationBudget() const { return _outputCache.budget(); }
+
+    /// Enables the output memoization of memoizable nodes.
+    /**
+   * Before a `NodeDelegateModel::memoizable()` node is evaluated by the
+   * topological propagation, the fingerprints of all its inputs are
+   * combined and looked up among its earlier results. The results are
+   * kept within `bytes` of memory, least recently used first out. A zero
+   * budget (the default) disables the memoization.
+   */
+    void setMemoizationBudget(std::size_t const bytes);
+
+    OutputCache const &outputCache() const { return _outputCache; }
+
+    /// Marks the node as one whose outputs are looked at.
+    /**
+   * In the `Lazy` mode the observed nodes and everything upstream of them
+   * are kept up to date; observing a node evaluates its pending inputs.
+   * Nodes without output ports are always treated as observed.
+   * DataFlowGraphicsScene observes the nodes with embedded widgets.
+   */
+    void setNodeObserved(NodeId const nodeId, bool const observed);
+
+    bool nodeObserved(NodeId const nodeId) const;
+
+    /// Brings the node up to date by evaluating its pending inputs and the
+    /// pending inputs of the nodes upstream. Intended for headless use of
+    /// the `Lazy` mode, in other modes there is nothing pending.
+    void evaluate(NodeId const nodeId);
+
+    /// Checks whether the inputs of the node were invalidated upstream and
+    /// no valid data arrived since, @see onOutPortDataInvalidated.
+    bool nodeInvalidated(NodeId const nodeId) const { return _invalidPorts.count(nodeId) > 0; }
+
+    /// Checks whether a computation of the node is running on a worker.
+    bool isComputing(NodeId const nodeId) const { return _runningNodes.count(nodeId) > 0; }
+
+    /// Flattens the current graph into an execution plan.
+    /**
+   * With `fuse` set, every tree of nodes providing a
+   * `NodeDelegateModel::fusableExpression()` is compiled into a single
+   * kernel; the output slots of the nodes inside such a tree stay empty.
+   */
+    ExecutionPlan compile(bool const fuse = false) const;
+
+    /// Evaluates every node of the plan once, in topological order.
+    /**
+   * `inputs` replace the outputs of the source nodes, i.e. the nodes
+   * without input ports; the remaining sources contribute their current
+   * outputs. All the outputs end up in `slots`, indexed by
+   * `ExecutionPlan::outputSlot`; reusing the same vector between the
+   * calls avoids allocations.
+   *
+   * The delegates compute with their signals blocked, so neither the
+   * propagation nor the scene take notice of the evaluation. The data
+   * the model remembers per port is updated to the evaluated one.
+   *
+   * @returns false without evaluating anything when the graph changed
+   * after the plan was compiled or a computation is still running.
+   */
+    bool execute(ExecutionPlan const &plan,
+                 ExecutionPlan::Inputs const &inputs,
+                 ExecutionPlan::Slots &slots);
+
     /**
    * Fetches the NodeDelegateModel for the given `nodeId` and tries to cast the
    * stored pointer to the given type
@@ -85,11 +339,11 @@ public:
     template<typename NodeDelegateModelType>
     NodeDelegateModelType *delegateModel(NodeId const nodeId)
     {
-        auto it = _models.find(nodeId);
-        if (it == _models.end())
+        NodeRecord *record = _nodes.find(nodeId);
+        if (!record)
             return nullptr;
 
-        auto model = dynamic_cast<NodeDelegateModelType *>(it->second.get());
+        auto model = dynamic_cast<NodeDelegateModelType *>(record->model.get());
 
         return model;
     }
@@ -97,6 +351,9 @@ public:
 Q_SIGNALS:
     void inPortDataWasSet(NodeId const, PortType const, PortIndex const);
 
+    /// Emitted when `addConnection` refuses a connection closing a cycle.
+    void connectionRejected(ConnectionId const connectionId);
+
 private:
     NodeId newNodeId() override { return _nextNodeId++; }
 
@@ -104,6 +361,27 @@ private:
 
     void sendConnectionDeletion(ConnectionId const connectionId);
 
+    /// Registers the connection in the per-port adjacency index.
+    void indexConnection(ConnectionId const connectionId);
+
+    /// Removes the connection from the per-port adjacency index.
+    void unindexConnection(ConnectionId const connectionId);
+
+    /// Re-reads and interns the port data types of the node.
+    /**
+   * Called when the node is created and whenever the delegate reports
+   * inserted or deleted ports. Delegates changing the type of an existing
+   * port are expected to go through the same signals.
+   */
+    void updatePortDataTypes(NodeId const nodeId);
+
+    /// Stores the delegate under the id and forwards its signals to the graph.
+    /**
+   * Shared by `addNode` and `loadNode`, the caller still sets up the port
+   * data types and announces the node.
+   */
+    void attachDelegate(NodeId const nodeId, std::unique_ptr<NodeDelegateModel> model);
+
 private Q_SLOTS:
     /**
    * Fuction is called in three cases:
@@ -117,19 +395,279 @@ private Q_SLOTS:
    */
     void onOutPortDataUpdated(NodeId const nodeId, PortIndex const portIndex);
 
+    /**
+   * Handles `NodeDelegateModel::dataInvalidated` in the topological modes.
+   *
+   * The whole downstream cone is marked invalid in one traversal: the
+   * delegates get `inputsInvalidated()` instead of a computation and the
+   * empty data following the invalidation is not propagated. An
+   * invalidated node computes again once valid data arrives on any of its
+   * inputs, the ports still invalid are then handed over empty.
+   *
+   * The remembered outputs of the invalidated nodes are dropped, so the
+   * first valid result afterwards is never cut off as unchanged. A node
+   * computing on a worker has its computation cancelled and is told
+   * about the invalidation once the worker is done with it.
+   */
+    void onOutPortDataInvalidated(NodeId const nodeId, PortIndex const portIndex);
+
     /// Function is called after detaching a connection.
     void propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex);
 
+    /// Hands the data to the input port according to the propagation mode.
+    /**
+   * The typed counterpart of `setPortData` with `PortRole::Data`, used on
+   * every internal hop: the data is moved along without being wrapped
+   * into a QVariant.
+   */
+    void deliverInData(NodeId const nodeId,
+                       PortIndex const portIndex,
+                       std::shared_ptr<NodeData> nodeData);
+
+private:
+    /// @returns the converter between the port types of the connection, if any.
+    TypeConverter const *connectionConverter(ConnectionId const &connectionId) const;
+
+    /// Converts the data leaving through the connection to the type of its input port.
+    std::shared_ptr<NodeData> convertData(ConnectionId const &connectionId,
+                                          std::shared_ptr<NodeData> nodeData) const;
+
+    /// Remembers the latest data for the input port and schedules the node.
+    void stageInData(NodeId const nodeId,
+                     PortIndex const portIndex,
+                     std::shared_ptr<NodeData> nodeData);
+
+    /**
+   * Hands the staged inputs over to the nodes in topological order. Nodes
+   * scheduled by the computations are processed within the same wave.
+   * Nested calls return immediately.
+   */
+    void runPropagationWave();
+
+    /// Checks whether the outputs of the node are needed in the `Lazy` mode.
+    bool isDemanded(NodeId const nodeId) const;
+
+    /// The demanding nodes and everything upstream of them, @see isDemanded.
+    NodeBitSet const &demandedNodes() const;
+
+    /**
+   * Moves the pending nodes that feed `nodeId`, the node itself included,
+   * back to the wave queue. @returns true if any node was moved.
+   */
+    bool schedulePendingUpstreamOf(NodeId const nodeId);
+
+    /// The `Streaming` counterpart of `runPropagationWave()`.
+    void runStreamingWave();
+
+    /// Checks whether the node has queued inputs and room for its outputs.
+    bool streamReady(NodeId const nodeId) const;
+
+    /// Pops one update from every non-empty input queue of the node.
+    NodeDelegateModel::PortDataList takeStreamInputs(NodeId const nodeId);
+
+    /// Appends to the connection queue, displacing the oldest update when full.
+    void enqueueStreamData(ConnectionId const &connectionId, std::shared_ptr<NodeData> nodeData);
+
+    /// Re-evaluates whether the node is held back by its outgoing queues.
+    void updateThrottling(NodeId const nodeId);
+
+    /// Checks whether a computation running or deferred upstream can still feed the node.
+    bool waitsForUpstream(NodeId const nodeId) const;
+
+    /// A node evaluated on a worker right after its only predecessor.
+    struct ChainLink
+    {
+        NodeId nodeId;
+        NodeDelegateModel *model;
+        CancellationToken token;
+        bool asyncTask;
+
+        /// Output ports of the predecessor paired with the input ports they feed.
+        std::vector<std::pair<PortIndex, PortIndex>> ports;
+
+        NodeDelegateModel::PortDataList inputs;
+        NodeDelegateModel::PortDataList outputs;
+
+        /// Cleared when the chain stopped before the node.
+        bool evaluated;
+    };
+
+    /// Everything a worker computation carries from dispatch to completion.
+    struct Computation
+    {
+        NodeId nodeId;
+        NodeDelegateModel *model;
+        CancellationToken token;
+        bool asyncTask;
+
+        /// Input fingerprint, zero when the result is not memoized.
+        std::uint64_t memoKey;
+
+        NodeDelegateModel::PortDataList inputs;
+        NodeDelegateModel::PortDataList outputs;
+
+        /// `AnyThread` nodes continuing the computation on the same worker.
+        std::vector<ChainLink> chain;
+    };
+
+    /// Collects the `AnyThread` nodes that can follow `nodeId` on its worker.
+    std::vector<ChainLink> chainDownstreamOf(NodeId const nodeId) const;
+
+    /**
+   * Runs either the asynchronous `task` or, when the task is empty,
+   * `setChangedInData` of a thread-safe node on the pool.
+   */
+    void dispatchToWorker(Computation computation, NodeDelegateModel::ComputeTask task);
+
+    /// Called on the GUI thread with the outputs produced on the worker.
+    void onWorkerFinished(Computation const &computation);
+
+    /**
+   * Stages the latest outputs of the node for the connections created
+   * while it was computing. They bypass `outputChanged`: a result equal
+   * to the previous one is new to those connections.
+   */
+    void stageLateConnections(NodeId const nodeId);
+
+    /// Tells the delegate about an invalidation deferred while it computed.
+    void finishInvalidation(NodeId const nodeId, NodeDelegateModel *model);
+
+    /// Releases the delegate of a node deleted while computing, @returns
+    /// false if the delegate is not retired.
+    bool releaseRetiredModel(NodeDelegateModel *model);
+
+    /// Sends the outputs of the node through its current connections,
+    /// except those leading to `skippedNode`.
+    void stageOutputs(NodeId const nodeId,
+                      NodeDelegateModel::PortDataList const &outputs,
+                      NodeId const skippedNode = InvalidNodeId);
+
+    /**
+   * Remembers the output of the node and @returns false when it equals
+   * the previous one, see `NodeData::equals`. The topological
+   * propagation stops at the outputs which did not change.
+   */
+    static bool outputChanged(NodeRecord &record,
+                              PortIndex const portIndex,
+                              std::shared_ptr<NodeData> const &nodeData);
+
+    /**
+   * Adds the remembered data of every input port missing from `inputs`
+   * when the delegate has stale inputs, so a computation following
+   * `NodeDelegateModel::setComputeResult` does not combine the changed
+   * inputs with operands the delegate never received.
+   */
+    static void completeInputs(NodeRecord &record, NodeDelegateModel::PortDataList &inputs);
+
+    /// Combines the fingerprints of all node inputs, zero if any is missing.
+    static std::uint64_t inputFingerprint(NodeRecord const &record);
+
+    /// Replaces the trees of fusable nodes in the plan with kernels.
+    void fuseArithmetic(ExecutionPlan &plan, std::vector<NodeId> const &order) const;
+
+    WorkStealingThreadPool &threadPool();
+
+    WorkStealingThreadPool &ioThread();
+
+    /// Checks whether the node is computed off the GUI thread.
+    bool runsOnWorker(NodeDelegateModel const *model,
+                      NodeDelegateModel::ComputeTask const &task) const;
+
 private:
     std::shared_ptr<NodeDelegateModelRegistry> _registry;
 
     NodeId _nextNodeId;
 
-    std::unordered_map<NodeId, std::unique_ptr<NodeDelegateModel>> _models;
+    NodeSlotMap<NodeRecord> _nodes;
 
     std::unordered_set<ConnectionId> _connectivity;
 
-    mutable std::unordered_map<NodeId, NodeGeometryData> _nodeGeometryData;
+    using PortKey = std::tuple<NodeId, PortType, PortIndex>;
+
+    /// Adjacency index mirroring `_connectivity`, answers port queries in O(degree).
+    std::unordered_map<PortKey, std::unordered_set<ConnectionId>> _portConnections;
+
+    /// Node-level order of the graph, keeps the data flow free of cycles.
+    TopologicalOrder _topology;
+
+    ReachabilityCache _reachability{_topology};
+
+    PropagationMode _propagationMode = PropagationMode::Cascade;
+
+    std::unordered_map<NodeId, NodeDelegateModel::PortDataList> _stagedInData;
+
+    /// Nodes with staged inputs ordered by their topological rank.
+    using RankedNode = std::pair<std::size_t, NodeId>;
+
+    std::priority_queue<RankedNode, std::vector<RankedNode>, std::greater<RankedNode>> _dirtyNodes;
+
+    bool _propagating = false;
+
+    /// Nodes computing on a worker with the tokens of their computations.
+    std::unordered_map<NodeId, CancellationToken> _runningNodes;
+
+    /// Output connections created while their node was computing.
+    std::unordered_map<NodeId, std::vector<ConnectionId>> _lateConnections;
+
+    /// Dirty nodes postponed until the computations upstream finish.
+    std::unordered_set<NodeId> _deferredNodes;
+
+    /// Dirty nodes skipped by the `Lazy` propagation, their inputs stay staged.
+    std::unordered_set<NodeId> _pendingNodes;
+
+    std::unordered_set<NodeId> _observedNodes;
+
+    /// Nodes without output ports.
+    std::unordered_set<NodeId> _sinkNodes;
+
+    /// Nodes requested through `evaluate()` and not up to date yet.
+    std::unordered_set<NodeId> _pullTargets;
+
+    /// Built by `demandedNodes()` again after a change of the graph or of
+    /// the three sets above, not on every query.
+    mutable NodeBitSet _demandedNodes;
+
+    mutable bool _demandedNodesValid = false;
+
+    /// `_graphRevision` the demanded nodes were built for.
+    mutable std::uint64_t _demandedNodesRevision = 0;
+
+    /// Delegates of the nodes deleted while computing on a worker.
+    std::vector<std::unique_ptr<NodeDelegateModel>> _retiredModels;
+
+    OutputCache _outputCache;
+
+    /// Incremented on every structural change, @see ExecutionPlan::revision.
+    std::uint64_t _graphRevision = 0;
+
+    /// Register file of the fused kernels, reused by every `execute`.
+    std::vector<double> _kernelRegisters;
+
+    int _coalescingInterval = -1;
+
+    std::vector<std::pair<NodeId, PortIndex>> _coalescedOutputs;
+
+    QTimer _coalescingTimer;
+
+    std::unordered_map<ConnectionId, std::deque<std::shared_ptr<NodeData>>> _streamQueues;
+
+    std::size_t _streamQueueCapacity = 4;
+
+    std::unordered_set<NodeId> _throttledNodes;
+
+    /// Input ports invalidated upstream, per node.
+    std::unordered_map<NodeId, std::vector<PortIndex>> _invalidPorts;
+
+    /// Nodes invalidated while computing, their delegates get
+    /// `inputsInvalidated()` when the worker finishes.
+    std::unordered_set<NodeId> _deferredInvalidations;
+
+    unsigned int _workerThreadCount = 0;
+
+    /// Declared last: joining the workers must precede destroying the nodes.
+    std::unique_ptr<WorkStealingThreadPool> _ioThread;
+
+    std::unique_ptr<WorkStealingThreadPool> _threadPool;
 };
 
 } // namespace QtNodes
@@ -33,6 +33,10 @@ public Q_SLOTS:
 Q_SIGNALS:
     void sceneLoaded();
 
+private:
+    /// Marks the node as observed by the model when it shows a widget.
+    void observeEmbeddedWidget(NodeId const nodeId);
+
 private:
     DataFlowGraphModel &_graphModel;
 };
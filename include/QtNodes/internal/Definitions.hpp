@@ -92,6 +92,11 @@ using NodeId = unsigned int;
 
 static constexpr NodeId InvalidNodeId = std::numeric_limits<NodeId>::max();
 
+/// Small integer interned for every distinct `NodeDataType::id`.
+using DataTypeId = unsigned int;
+
+static constexpr DataTypeId InvalidDataTypeId = std::numeric_limits<DataTypeId>::max();
+
 /**
  * A unique connection identificator that stores
  * out `NodeId`, out `PortIndex`, in `NodeId`, in `PortIndex`
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "NodeData.hpp"
+#include "TypeConverter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+class NodeDelegateModel;
+
+/**
+ * Immutable, flattened form of a DataFlowGraphModel for repeated headless
+ * evaluation.
+ *
+ * Every output port of every node owns one slot in a flat array of
+ * `NodeData` pointers. The nodes are stored as a linear sequence of steps
+ * in topological order and each input port refers directly to the slot
+ * of the output feeding it, so running the plan needs neither map
+ * look-ups nor signal dispatch.
+ *
+ * A plan is created by `DataFlowGraphModel::compile()` and executed by
+ * `DataFlowGraphModel::execute()`. It refers to the delegates of the
+ * model and becomes stale as soon as the graph structure changes.
+ *
+ * Trees of nodes described by a `FusableExpression` may be compiled into
+ * kernels: a small register bytecode evaluated on doubles in place of
+ * the delegates. The steps of the fused nodes are kept for the inputs
+ * the kernel can not read as scalars.
+ *
+ * The type converters of the connections are copied into the plan, so
+ * registering converters afterwards does not affect it.
+ */
+class NODE_EDITOR_PUBLIC ExecutionPlan
+{
+public:
+    using SlotIndex = std::uint32_t;
+
+    static constexpr SlotIndex InvalidSlot = std::numeric_limits<SlotIndex>::max();
+
+    static constexpr std::uint32_t NoKernel = std::numeric_limits<std::uint32_t>::max();
+
+    static constexpr std::uint32_t NoConverter = std::numeric_limits<std::uint32_t>::max();
+
+    /// Values fed into the output slots of the source nodes.
+    using Inputs = std::vector<std::pair<SlotIndex, std::shared_ptr<NodeData>>>;
+
+    using Slots = std::vector<std::shared_ptr<NodeData>>;
+
+    struct Step
+    {
+        NodeId nodeId;
+
+        NodeDelegateModel *model;
+
+        /// Range in `inputBindings()`.
+        std::uint32_t firstInput;
+        std::uint32_t inputCount;
+
+        /// Range of the output slots.
+        SlotIndex firstOutput;
+        std::uint32_t outputCount;
+
+        /// Kernel computing the node together with the fused nodes upstream.
+        std::uint32_t kernel = NoKernel;
+
+        /// The node is computed by the kernel of a node downstream.
+        bool fused = false;
+    };
+
+    struct InputBinding
+    {
+        PortIndex portIndex;
+
+        /// Slot feeding the port, `InvalidSlot` for an unconnected port.
+        SlotIndex slot;
+
+        /// Index in `converters()` for a connection between different types.
+        std::uint32_t converter;
+    };
+
+    struct Instruction
+    {
+        enum class Opcode : std::uint8_t { Load, Add, Subtract, Multiply, Divide };
+
+        Opcode opcode;
+
+        /// Registers, a kernel uses at most three per fused node.
+        std::uint32_t target;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+
+        /// Operand of `Load`.
+        SlotIndex slot;
+    };
+
+    struct Kernel
+    {
+        /// Range in `instructions()`, the last one produces the result.
+        std::uint32_t firstInstruction;
+        std::uint32_t instructionCount;
+
+        /// Steps of the fused nodes in evaluation order.
+        std::vector<std::uint32_t> fusedSteps;
+
+        std::function<std::shared_ptr<NodeData>(double)> makeData;
+    };
+
+    enum class KernelStatus {
+        Value,
+
+        /// An operand is missing or a division by zero occurred.
+        Empty,
+
+        /// An operand is not a scalar, the fused steps have to run.
+        Unsupported
+    };
+
+public:
+    bool empty() const { return _steps.empty(); }
+
+    std::size_t slotCount() const { return _slotCount; }
+
+    /// @returns the slot of the given output port or `InvalidSlot`.
+    /**
+   * The function is meant to be called once while setting up the inputs
+   * and reading the results, not inside the evaluation loop.
+   */
+    SlotIndex outputSlot(NodeId const nodeId, PortIndex const portIndex) const;
+
+    std::vector<Step> const &steps() const { return _steps; }
+
+    std::vector<InputBinding> const &inputBindings() const { return _inputBindings; }
+
+    std::vector<TypeConverter> const &converters() const { return _converters; }
+
+    /// Largest number of inputs of a single step.
+    std::size_t maxInputCount() const { return _maxInputCount; }
+
+    std::vector<Kernel> const &kernels() const { return _kernels; }
+
+    std::vector<Instruction> const &instructions() const { return _instructions; }
+
+    /// Largest number of registers used by a single kernel.
+    std::size_t registerCount() const { return _registerCount; }
+
+    /// Interprets the kernel in the given register file.
+    /**
+   * `registers` holds at least `registerCount()` values and belongs to
+   * the caller, so the plan itself is never modified.
+   */
+    KernelStatus runKernel(Kernel const &kernel,
+                           Slots const &slots,
+                           std::vector<double> &registers,
+                           double &value) const;
+
+    /// Graph revision the plan was compiled from.
+    std::uint64_t revision() const { return _revision; }
+
+private:
+    friend class DataFlowGraphModel;
+
+    std::vector<Step> _steps;
+
+    /// Positions of the node records of the steps in the storage of the
+    /// graph model, valid for `revision()`.
+    std::vector<std::uint32_t> _recordPositions;
+
+    std::vector<InputBinding> _inputBindings;
+
+    std::vector<TypeConverter> _converters;
+
+    std::unordered_map<NodeId, std::pair<SlotIndex, std::uint32_t>> _outputSlots;
+
+    std::size_t _slotCount = 0;
+
+    std::size_t _maxInputCount = 0;
+
+    std::vector<Kernel> _kernels;
+
+    std::vector<Instruction> _instructions;
+
+    std::size_t _registerCount = 0;
+
+    std::uint64_t _revision = 0;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace QtNodes {
+
+template<typename Signature>
+class FunctionRef;
+
+/**
+ * A non-owning reference to a callable object.
+ *
+ * Unlike `std::function` the class never allocates, which makes it
+ * suitable for visitor callbacks invoked on the painting and dragging
+ * paths. The referenced callable must outlive the `FunctionRef`, so the
+ * class is meant to be used for function parameters only.
+ */
+template<typename Result, typename... Args>
+class FunctionRef<Result(Args...)>
+{
+public:
+    template<typename Callable,
+             typename = typename std::enable_if<
+                 !std::is_same<typename std::decay<Callable>::type, FunctionRef>::value>::type>
+    FunctionRef(Callable &&callable)
+        : _callable(const_cast<void *>(static_cast<void const *>(&callable)))
+        , _invoke(&invokeCallable<typename std::remove_reference<Callable>::type>)
+    {}
+
+    Result operator()(Args... args) const
+    {
+        return _invoke(_callable, std::forward<Args>(args)...);
+    }
+
+private:
+    template<typename Callable>
+    static Result invokeCallable(void *callable, Args... args)
+    {
+        return (*static_cast<Callable *>(callable))(std::forward<Args>(args)...);
+    }
+
+private:
+    void *_callable;
+
+    Result (*_invoke)(void *, Args...);
+};
+
+} // namespace QtNodes
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "NodeData.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace QtNodes {
+
+/**
+ * Describes a node computing a binary arithmetic operation of its two
+ * scalar inputs into its only output.
+ *
+ * Nodes with such a description can be fused by
+ * `DataFlowGraphModel::compile`: a tree of them is evaluated as one
+ * bytecode kernel working on plain doubles, so the intermediate results
+ * are neither wrapped into NodeData nor passed through the delegates.
+ * The operands are read with `NodeData::scalarValue`.
+ */
+struct FusableExpression
+{
+    enum class Operation {
+        None,
+        Add,
+        Subtract,
+        Multiply,
+
+        /// Division by zero gives an empty output.
+        Divide
+    };
+
+    Operation operation = Operation::None;
+
+    /// Wraps the computed value into the data of the output port.
+    std::function<std::shared_ptr<NodeData>(double)> makeData;
+};
+
+} // namespace QtNodes
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include <QtCore/QObject>
@@ -36,6 +38,47 @@ public:
 
     /// Type for inner use
     virtual NodeDataType type() const = 0;
+
+    /// Hash of the type and the payload.
+    /**
+   * Used by the output memoization of DataFlowGraphModel: equal
+   * fingerprints must mean equal data. The default `0` tells that the
+   * data can not be fingerprinted and disables the memoization for the
+   * nodes receiving it.
+   */
+    virtual std::uint64_t fingerprint() const { return 0; }
+
+    /// Compares the payloads.
+    /**
+   * DataFlowGraphModel does not propagate an output equal to the previous
+   * one, so the nodes downstream do not recompute. The default compares
+   * the fingerprints; data without a fingerprint is never equal.
+   */
+    virtual bool equals(NodeData const &other) const
+    {
+        std::uint64_t const hash = fingerprint();
+
+        return hash != 0 && hash == other.fingerprint();
+    }
+
+    /// Changes whenever the payload is modified in place.
+    /**
+   * DataFlowGraphModel compares it when a node emits the same data object
+   * again, so such an update is not cut off as unchanged. The default
+   * suits the data which is never modified once emitted.
+   */
+    virtual std::uint64_t revision() const { return 0; }
+
+    /// Approximate memory footprint, counted against the memoization budget.
+    virtual std::size_t byteSize() const { return sizeof(*this); }
+
+    /// Reads the payload as a single number, used by the fused kernels.
+    /// @returns false for the data which is not a scalar.
+    virtual bool scalarValue(double &value) const
+    {
+        Q_UNUSED(value);
+        return false;
+    }
 };
 
 } // namespace QtNodes
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+/**
+ * Recycles the memory of the NodeData objects of type `T`.
+ *
+ * `make()` is a drop-in replacement for `std::make_shared<T>()`. The
+ * object and the reference counts live in one block as usual, but the
+ * block is returned to a free list of the pool when the last reference
+ * goes away, and the next `make()` reuses it instead of calling the
+ * global allocator. All the functions are thread-safe, so nodes
+ * computing on worker threads may share the pool.
+ *
+ * Every instantiation has a pool of its own: the blocks of one type are
+ * all of the size of its `std::allocate_shared` block and never handed
+ * to another type.
+ */
+template<typename T>
+class NodeDataPool
+{
+public:
+    template<typename... Args>
+    static std::shared_ptr<T> make(Args &&...args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+    }
+
+    /// Number of `make()` calls served from the free list.
+    static std::uint64_t hits() { return state().hits.load(std::memory_order_relaxed); }
+
+    /// Number of `make()` calls which had to allocate.
+    static std::uint64_t misses() { return state().misses.load(std::memory_order_relaxed); }
+
+    static double hitRate()
+    {
+        std::uint64_t const total = hits() + misses();
+
+        return total ? static_cast<double>(hits()) / static_cast<double>(total) : 0.0;
+    }
+
+    static std::size_t capacity()
+    {
+        State &s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        return s.capacity;
+    }
+
+    /// Bounds the number of free blocks kept for reuse, 1024 by default.
+    static void setCapacity(std::size_t const blocks)
+    {
+        State &s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        s.capacity = blocks;
+
+        while (s.freeBlocks.size() > s.capacity) {
+            ::operator delete(s.freeBlocks.back());
+            s.freeBlocks.pop_back();
+        }
+    }
+
+    /// Releases the free blocks and resets the statistics.
+    static void clear()
+    {
+        State &s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        for (void *block : s.freeBlocks) {
+            ::operator delete(block);
+        }
+
+        s.freeBlocks.clear();
+        s.hits = 0;
+        s.misses = 0;
+    }
+
+private:
+    struct State
+    {
+        std::mutex mutex;
+
+        std::vector<void *> freeBlocks;
+
+        /// Size of the blocks, known after the first allocation.
+        std::size_t blockSize = 0;
+
+        std::size_t capacity = 1024;
+
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    /// Never destroyed: data may outlive the static objects at exit.
+    static State &state()
+    {
+        static State *const s = new State;
+
+        return *s;
+    }
+
+    static void *acquire(std::size_t const size)
+    {
+        State &s = state();
+
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            if (s.blockSize == 0)
+                s.blockSize = size;
+
+            if (size == s.blockSize && !s.freeBlocks.empty()) {
+                void *block = s.freeBlocks.back();
+                s.freeBlocks.pop_back();
+
+                s.hits.fetch_add(1, std::memory_order_relaxed);
+
+                return block;
+            }
+        }
+
+        s.misses.fetch_add(1, std::memory_order_relaxed);
+
+        return ::operator new(size);
+    }
+
+    static void release(void *block, std::size_t const size)
+    {
+        State &s = state();
+
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            if (size == s.blockSize && s.freeBlocks.size() < s.capacity) {
+                s.freeBlocks.push_back(block);
+                return;
+            }
+        }
+
+        ::operator delete(block);
+    }
+
+    /// Rebound by `std::allocate_shared` to the block holding T and its counts.
+    template<typename U>
+    struct Allocator
+    {
+        using value_type = U;
+
+        Allocator() = default;
+
+        template<typename V>
+        Allocator(Allocator<V> const &)
+        {}
+
+        U *allocate(std::size_t const count)
+        {
+            // The blocks come from the plain operator new.
+            static_assert(alignof(U) <= alignof(std::max_align_t),
+                          "NodeDataPool does not support over-aligned data");
+
+            return static_cast<U *>(NodeDataPool::acquire(count * sizeof(U)));
+        }
+
+        void deallocate(U *block, std::size_t const count)
+        {
+            NodeDataPool::release(block, count * sizeof(U));
+        }
+
+        template<typename V>
+        bool operator==(Allocator<V> const &) const
+        {
+            return true;
+        }
+
+        template<typename V>
+        bool operator!=(Allocator<V> const &) const
+        {
+            return false;
+        }
+    };
+};
+
+} // namespace QtNodes
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <QtWidgets/QWidget>
 
+#include "CancellationToken.hpp"
 #include "Definitions.hpp"
 #include "Export.hpp"
+#include "FusableExpression.hpp"
 #include "NodeData.hpp"
 #include "NodeStyle.hpp"
 #include "Serializable.hpp"
@@ -59,11 +64,62 @@ public:
 
     NodeStyle const &nodeStyle() const;
 
+    /// Emits `nodeStyleUpdated`.
     void setNodeStyle(NodeStyle const &style);
 
 public:
     virtual void setInData(std::shared_ptr<NodeData> nodeData, PortIndex const portIndex) = 0;
 
+    using PortDataList = std::vector<std::pair<PortIndex, std::shared_ptr<NodeData>>>;
+
+    /// Receives all the inputs changed during one propagation wave.
+    /**
+   * The topological propagation of DataFlowGraphModel collects the new
+   * data for every input port first and hands it over in a single call,
+   * so a node fed by several changed inputs can compute just once. The
+   * default implementation calls `setInData` for every entry.
+   */
+    virtual void setChangedInData(PortDataList const &inputs);
+
+    /// Computation producing the new output data, @see computeTask.
+    using ComputeTask = std::function<PortDataList(CancellationToken const &)>;
+
+    /// Creates an asynchronous computation for the changed inputs.
+    /**
+   * The function is called by the topological propagation of
+   * DataFlowGraphModel instead of `setChangedInData`, on the GUI thread
+   * unless the node runs with the `AnyThread` affinity. A
+   * non-empty task is executed on a worker thread and must only use the
+   * data captured by value; it returns the new data for the output ports.
+   * The task should poll the token and return early once it gets
+   * cancelled, which happens when newer inputs arrive before it finished.
+   *
+   * The default implementation returns an empty task and the node is
+   * evaluated synchronously through `setChangedInData`.
+   */
+    virtual ComputeTask computeTask(PortDataList const &inputs);
+
+    /// Receives the outputs of a completed, not cancelled `computeTask`.
+    /**
+   * Called on the GUI thread before the outputs are propagated
+   * downstream by the graph model, so there is no need to emit
+   * `dataUpdated` here. Nodes should keep the data to answer `outData`.
+   * The default implementation drops the outputs.
+   */
+    virtual void setComputeResult(PortDataList const &outputs);
+
+    /// False once the default `setComputeResult` dropped some outputs.
+    bool acceptsComputeResult() const { return _acceptsComputeResult; }
+
+    /// Called instead of a computation when the data upstream became invalid.
+    /**
+   * The node should drop its results, i.e. answer `outData` with empty
+   * data. It computes again once valid data arrives. The default hands
+   * empty data to every input port through `setInData`, the signals the
+   * node emits meanwhile are blocked by DataFlowGraphModel.
+   */
+    virtual void inputsInvalidated();
+
     virtual std::shared_ptr<NodeData> outData(PortIndex const port) = 0;
 
     /**
@@ -80,6 +136,75 @@ public:
 
     virtual bool resizable() const { return false; }
 
+    /// Opts the node into the evaluation on worker threads.
+    /**
+   * Deprecated, override `affinity()` returning `ExecutionAffinity::AnyThread`
+   * instead. Still honoured by the default `affinity()`.
+   *
+   * When DataFlowGraphModel runs with worker threads, `setInData`,
+   * `setChangedInData` and the subsequent `outData` calls of a node
+   * returning `true` here may be executed on a worker thread. Such a node
+   * must not touch widgets or other GUI-thread objects while computing;
+   * emitting `dataUpdated` is fine, the results are marshalled back to the
+   * GUI thread by the graph model. The graph model never runs two
+   * computations of the same node at once.
+   */
+    Q_DECL_DEPRECATED_X("Override affinity() instead")
+    virtual bool threadSafe() const { return false; }
+
+    /// Threads the data-flow runtime may evaluate the node on.
+    enum class ExecutionAffinity {
+        /// Only the GUI thread, e.g. the node updates its embedded widget.
+        Gui,
+
+        /// Any worker thread, the node is a pure computation.
+        AnyThread,
+
+        /// A dedicated thread shared by all the blocking I/O nodes, so
+        /// they neither stall the GUI nor occupy the compute workers.
+        IoThread
+    };
+
+    /// The default derives the affinity from the deprecated `threadSafe()`.
+    /**
+   * The methods called while computing, i.e. `setInData`,
+   * `setChangedInData`, `computeTask` and `outData`, run on the declared
+   * thread. DataFlowGraphModel moves the data between the threads only
+   * where the affinity of adjacent nodes differs: a chain of `AnyThread`
+   * nodes is evaluated on one worker without returning to the GUI thread.
+   */
+    virtual ExecutionAffinity affinity() const
+    {
+        QT_WARNING_PUSH
+        QT_WARNING_DISABLE_DEPRECATED
+        return threadSafe() ? ExecutionAffinity::AnyThread : ExecutionAffinity::Gui;
+        QT_WARNING_POP
+    }
+
+    /// Opts the node into the output memoization of DataFlowGraphModel.
+    /**
+   * A memoizable node produces outputs depending on its inputs only. When
+   * the fingerprints of all its inputs match an earlier evaluation, the
+   * cached outputs are handed to `setComputeResult` instead of computing,
+   * so the node has to restore its `outData` from there; a node keeping
+   * the default implementation computes on every evaluation. The inputs
+   * are not handed over on a hit; the next computation receives all of
+   * them, not only the changed ones.
+   *
+   * The cached outputs of a node are dropped when it emits `dataUpdated`
+   * on its own, e.g. after a parameter change, when it is loaded and when
+   * its ports change. Nodes whose outputs change silently must not opt in.
+   */
+    virtual bool memoizable() const { return false; }
+
+    /// Arithmetic the node performs, @see FusableExpression.
+    /**
+   * The fused kernels restore the outputs of the last node of a tree with
+   * `setComputeResult`. The default describes no operation and the node
+   * is never fused.
+   */
+    virtual FusableExpression fusableExpression() const { return FusableExpression(); }
+
 public Q_SLOTS:
 
     virtual void inputConnectionCreated(ConnectionId const &) {}
@@ -102,8 +227,18 @@ Q_SIGNALS:
 
     void computingFinished();
 
+    /// Emitted by DataFlowGraphModel in the `Streaming` mode.
+    /**
+   * `throttled` becomes true when a connection queue fed by the node is
+   * full and false once there is room again. Sources should pause while
+   * throttled: their further outputs displace the oldest queued data.
+   */
+    void backpressureChanged(bool const throttled);
+
     void embeddedWidgetSizeUpdated();
 
+    void nodeStyleUpdated();
+
     /// Call this function before deleting the data associated with ports.
     /**
    * The function notifies the Graph Model and makes it remove and recompute the
@@ -128,6 +263,8 @@ Q_SIGNALS:
 
 private:
     NodeStyle _nodeStyle;
+
+    bool _acceptsComputeResult = true;
 };
 
 } // namespace QtNodes
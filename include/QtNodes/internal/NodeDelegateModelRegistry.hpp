@@ -1,12 +1,15 @@
 #pragma once
 
+#include "Definitions.hpp"
 #include "Export.hpp"
 #include "NodeData.hpp"
 #include "NodeDelegateModel.hpp"
 #include "QStringStdHash.hpp"
+#include "TypeConverter.hpp"
 
 #include <QtCore/QString>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <set>
@@ -27,8 +30,6 @@ public:
     using RegisteredModelsCategoryMap = std::unordered_map<QString, QString>;
     using CategoriesSet = std::set<QString>;
 
-    //using RegisteredTypeConvertersMap = std::map<TypeConverterId, TypeConverter>;
-
     NodeDelegateModelRegistry() = default;
     ~NodeDelegateModelRegistry() = default;
 
@@ -84,16 +85,19 @@ public:
     registerModel(std::forward<ModelCreator>(creator), category);
   }
 
-
-  void
-  registerTypeConverter(TypeConverterId const& id,
-                        TypeConverter          typeConverter)
-  {
-    _registeredTypeConverters[id] = std::move(typeConverter);
-  }
-
 #endif
 
+    /// Lets the output type `id.first` connect to the input type `id.second`.
+    /**
+   * DataFlowGraphModel applies the converter on every connection between
+   * the two types, no conversion node is needed. An empty converter
+   * declares the representations compatible: the data is passed as is.
+   * Registering the pair again replaces its converter, registering an
+   * empty one drops the converter but leaves the pair compatible, with
+   * the data passed as is.
+   */
+    void registerTypeConverter(TypeConverterId const &id, TypeConverter typeConverter);
+
     std::unique_ptr<NodeDelegateModel> create(QString const &modelName);
 
     RegisteredModelCreatorsMap const &registeredModelCreators() const;
@@ -102,11 +106,66 @@ public:
 
     CategoriesSet const &categories() const;
 
-#if 0
-  TypeConverter
-  getTypeConverter(NodeDataType const& d1,
-                   NodeDataType const& d2) const;
-#endif
+    /// @returns the interned integer for the given `NodeDataType::id`.
+    /**
+   * Unknown ids are registered on the first call. Every type is
+   * compatible with itself.
+   */
+    DataTypeId dataTypeId(QString const &typeId);
+
+    DataTypeId dataTypeId(NodeDataType const &dataType) { return dataTypeId(dataType.id); }
+
+    /// Same as `dataTypeId` but never registers, @returns `InvalidDataTypeId` instead.
+    DataTypeId findDataTypeId(QString const &typeId) const;
+
+    std::size_t dataTypeCount() const { return _dataTypeIds.size(); }
+
+    /// Checks whether data produced by `outType` can be fed to `inType`.
+    /**
+   * The answer is read from a precomputed table, so the call costs an
+   * index computation and a single load.
+   */
+    bool dataTypesCompatible(DataTypeId const outType, DataTypeId const inType) const
+    {
+        std::size_t const n = _dataTypeIds.size();
+
+        if (outType >= n || inType >= n)
+            return false;
+
+        return _typeCompatibility[outType * _typeStride + inType] != Incompatible;
+    }
+
+    /// @returns the converter applied between the types, nullptr if the
+    /// data passes unchanged or the types are not compatible at all.
+    /**
+   * Read from the same table as `dataTypesCompatible`. The pointer stays
+   * valid until the next call of `registerTypeConverter`.
+   */
+    TypeConverter const *typeConverter(DataTypeId const outType, DataTypeId const inType) const
+    {
+        std::size_t const n = _dataTypeIds.size();
+
+        if (outType >= n || inType >= n)
+            return nullptr;
+
+        std::uint32_t const cell = _typeCompatibility[outType * _typeStride + inType];
+
+        return (cell >= FirstConverter) ? &_typeConverters[cell - FirstConverter] : nullptr;
+    }
+
+    /// @returns a copy of the converter registered for the pair or an empty one.
+    TypeConverter getTypeConverter(NodeDataType const &d1, NodeDataType const &d2) const;
+
+    /// Number of the non-empty converters registered.
+    std::size_t typeConverterCount() const
+    {
+        return _typeConverters.size() - _freeConverterSlots.size();
+    }
+
+private:
+    /// Empties the converter slot referenced by the compatibility `cell`
+    /// and keeps it for the next converter registered.
+    void eraseTypeConverter(std::uint32_t const cell);
 
 private:
     RegisteredModelsCategoryMap _registeredModelsCategory;
@@ -115,9 +174,24 @@ private:
 
     RegisteredModelCreatorsMap _registeredItemCreators;
 
-#if 0
-  RegisteredTypeConvertersMap _registeredTypeConverters;
-#endif
+    std::unordered_map<QString, DataTypeId> _dataTypeIds;
+
+    /// Values of the compatibility cells, larger ones index `_typeConverters`.
+    enum : std::uint32_t { Incompatible = 0, Compatible = 1, FirstConverter = 2 };
+
+    /// Row-major table, rows are output types.
+    /**
+   * Rows and columns are `_typeStride` long, the capacity grows by
+   * doubling so interning a type rarely copies the table.
+   */
+    std::vector<std::uint32_t> _typeCompatibility;
+
+    std::size_t _typeStride = 0;
+
+    std::vector<TypeConverter> _typeConverters;
+
+    /// Indices of the emptied slots of `_typeConverters`.
+    std::vector<std::uint32_t> _freeConverterSlots;
 
 private:
     // If the registered ModelType class has the static member method
@@ -4,6 +4,7 @@
 #include <QtWidgets/QGraphicsObject>
 
 #include "NodeState.hpp"
+#include "NodeStyle.hpp"
 
 class QGraphicsProxyWidget;
 
@@ -39,6 +40,12 @@ public:
 
     NodeState const &nodeState() const { return _nodeState; }
 
+    /// The style of the node, parsed once instead of on every repaint.
+    NodeStyle const &nodeStyle() const { return _nodeStyle; }
+
+    /// Re-reads the style from the graph model, e.g. after `nodeUpdated`.
+    void updateNodeStyle();
+
     QRectF boundingRect() const override;
 
     void setGeometryChanged();
@@ -87,6 +94,8 @@ private:
 
     NodeState _nodeState;
 
+    NodeStyle _nodeStyle;
+
     // either nullptr or owned by parent QGraphicsItem
     QGraphicsProxyWidget *_proxyWidget;
 };
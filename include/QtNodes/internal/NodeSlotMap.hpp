@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+/**
+ * Dense generational storage for per-node records.
+ *
+ * Records live contiguously in a single vector, so a full-graph
+ * iteration walks linear memory. A paged sparse array maps the `NodeId`
+ * values below `DirectIdLimit`, in practice all the ids generated by the graph
+ * model, onto the positions of their records without hashing. Larger
+ * ids, e.g. coming from a hand-edited file, are mapped through a hash
+ * table instead, so the memory of the sparse array stays bounded. Node
+ * ids themselves are not changed by the container and stay stable for
+ * serialization.
+ *
+ * Every slot counts how many times a record was erased from it. A
+ * `Handle` remembers that generation and becomes invalid as soon as the
+ * node is deleted, even if the same id is restored later on.
+ */
+template<typename T>
+class NodeSlotMap
+{
+public:
+    struct Entry
+    {
+        NodeId nodeId;
+        T value;
+    };
+
+    struct Handle
+    {
+        NodeId nodeId;
+        std::uint32_t generation;
+    };
+
+    using iterator = typename std::vector<Entry>::iterator;
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+public:
+    bool contains(NodeId const nodeId) const { return denseIndex(nodeId) != InvalidIndex; }
+
+    bool isValid(Handle const handle) const
+    {
+        Slot const *slot = findSlot(handle.nodeId);
+
+        return slot && slot->dense != InvalidIndex && slot->generation == handle.generation;
+    }
+
+    Handle handle(NodeId const nodeId) const
+    {
+        Slot const *slot = findSlot(nodeId);
+
+        return Handle{nodeId, slot ? slot->generation : 0u};
+    }
+
+    T *find(NodeId const nodeId)
+    {
+        std::uint32_t const index = denseIndex(nodeId);
+
+        return (index != InvalidIndex) ? &_dense[index].value : nullptr;
+    }
+
+    T const *find(NodeId const nodeId) const
+    {
+        std::uint32_t const index = denseIndex(nodeId);
+
+        return (index != InvalidIndex) ? &_dense[index].value : nullptr;
+    }
+
+    /// Position of the record in the iteration order.
+    /**
+   * The position stays valid until the next insertion of a new id or
+   * erasure, @see at.
+   */
+    std::uint32_t position(NodeId const nodeId) const { return denseIndex(nodeId); }
+
+    T &at(std::uint32_t const position) { return _dense[position].value; }
+
+    /// Inserts a new record or replaces the existing one.
+    T &insert(NodeId const nodeId, T value)
+    {
+        Slot &slot = slotFor(nodeId);
+
+        if (slot.dense != InvalidIndex) {
+            _dense[slot.dense].value = std::move(value);
+        } else {
+            slot.dense = static_cast<std::uint32_t>(_dense.size());
+            _dense.push_back(Entry{nodeId, std::move(value)});
+        }
+
+        return _dense[slot.dense].value;
+    }
+
+    /// Removes the record, the last record is moved into the freed position.
+    bool erase(NodeId const nodeId)
+    {
+        Slot *slot = findSlot(nodeId);
+
+        if (!slot || slot->dense == InvalidIndex)
+            return false;
+
+        std::uint32_t const index = slot->dense;
+
+        if (index + 1 != _dense.size()) {
+            _dense[index] = std::move(_dense.back());
+            findSlot(_dense[index].nodeId)->dense = index;
+        }
+
+        _dense.pop_back();
+
+        // The slot of a large id is kept as well, so is its generation.
+        slot->dense = InvalidIndex;
+        ++slot->generation;
+
+        return true;
+    }
+
+    std::size_t size() const { return _dense.size(); }
+
+    bool empty() const { return _dense.empty(); }
+
+    iterator begin() { return _dense.begin(); }
+
+    iterator end() { return _dense.end(); }
+
+    const_iterator begin() const { return _dense.begin(); }
+
+    const_iterator end() const { return _dense.end(); }
+
+public:
+    /// Ids from this one on are not stored in the sparse array.
+    static constexpr NodeId DirectIdLimit = 1u << 20;
+
+private:
+    static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    static constexpr std::size_t PageSize = 256;
+
+    struct Slot
+    {
+        /// Position of the record in `_dense`.
+        std::uint32_t dense = InvalidIndex;
+        std::uint32_t generation = 0;
+    };
+
+    using Page = std::array<Slot, PageSize>;
+
+    Slot const *findSlot(NodeId const nodeId) const
+    {
+        if (nodeId >= DirectIdLimit) {
+            auto it = _overflow.find(nodeId);
+
+            return (it != _overflow.end()) ? &it->second : nullptr;
+        }
+
+        std::size_t const page = nodeId / PageSize;
+
+        if (page >= _pages.size() || !_pages[page])
+            return nullptr;
+
+        return &(*_pages[page])[nodeId % PageSize];
+    }
+
+    Slot *findSlot(NodeId const nodeId)
+    {
+        return const_cast<Slot *>(static_cast<NodeSlotMap const *>(this)->findSlot(nodeId));
+    }
+
+    /// @returns the slot of the id, creating it when needed.
+    Slot &slotFor(NodeId const nodeId)
+    {
+        if (nodeId >= DirectIdLimit)
+            return _overflow[nodeId];
+
+        std::size_t const page = nodeId / PageSize;
+
+        if (page >= _pages.size())
+            _pages.resize(page + 1);
+
+        if (!_pages[page])
+            _pages[page] = std::make_unique<Page>();
+
+        return (*_pages[page])[nodeId % PageSize];
+    }
+
+    std::uint32_t denseIndex(NodeId const nodeId) const
+    {
+        Slot const *slot = findSlot(nodeId);
+
+        return slot ? slot->dense : InvalidIndex;
+    }
+
+private:
+    std::vector<Entry> _dense;
+
+    std::vector<std::unique_ptr<Page>> _pages;
+
+    std::unordered_map<NodeId, Slot> _overflow;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "NodeDelegateModel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace QtNodes {
+
+/**
+ * Memory-bounded LRU cache of node outputs keyed by input fingerprints.
+ *
+ * Every entry stores the outputs a node produced for one combination of
+ * inputs. The size of an entry is estimated through
+ * `NodeData::byteSize()`; once the total exceeds the budget, the least
+ * recently used entries are evicted.
+ */
+class NODE_EDITOR_PUBLIC OutputCache
+{
+public:
+    std::size_t budget() const { return _budget; }
+
+    /// Sets the budget in bytes, a zero budget disables the cache.
+    void setBudget(std::size_t const bytes);
+
+    std::size_t usedBytes() const { return _usedBytes; }
+
+    /// @returns the cached outputs or `nullptr`, a hit refreshes the entry.
+    NodeDelegateModel::PortDataList const *find(NodeId const nodeId,
+                                                std::uint64_t const fingerprint);
+
+    void insert(NodeId const nodeId,
+                std::uint64_t const fingerprint,
+                NodeDelegateModel::PortDataList outputs);
+
+    /// Drops all the entries of the node.
+    void invalidateNode(NodeId const nodeId);
+
+    void clear();
+
+    std::size_t hits() const { return _hits; }
+
+    std::size_t misses() const { return _misses; }
+
+private:
+    using Key = std::pair<NodeId, std::uint64_t>;
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const &key) const
+        {
+            return std::hash<std::uint64_t>()(key.second ^ (std::uint64_t(key.first) << 32));
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        NodeDelegateModel::PortDataList outputs;
+        std::size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void erase(EntryList::iterator const it);
+
+    void evict();
+
+private:
+    std::size_t _budget = 0;
+
+    std::size_t _usedBytes = 0;
+
+    /// Most recently used entries first.
+    EntryList _entries;
+
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+
+    /// Fingerprints of the entries of every node.
+    std::unordered_map<NodeId, std::unordered_set<std::uint64_t>> _nodeEntries;
+
+    std::size_t _hits = 0;
+
+    std::size_t _misses = 0;
+};
+
+} // namespace QtNodes
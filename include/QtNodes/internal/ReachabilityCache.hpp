@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace QtNodes {
+
+class TopologicalOrder;
+
+/// Set of small dense indices stored as a bit per index.
+class NODE_EDITOR_PUBLIC NodeBitSet
+{
+public:
+    void insert(std::uint32_t const index)
+    {
+        std::size_t const word = index / WordBits;
+
+        if (word >= _words.size())
+            _words.resize(word + 1, 0);
+
+        _words[word] |= std::uint64_t(1) << (index % WordBits);
+    }
+
+    /// Adds all the indices of `other`.
+    void unite(NodeBitSet const &other)
+    {
+        if (other._words.size() > _words.size())
+            _words.resize(other._words.size(), 0);
+
+        for (std::size_t word = 0; word < other._words.size(); ++word) {
+            _words[word] |= other._words[word];
+        }
+    }
+
+    void clear() { _words.clear(); }
+
+    bool contains(std::uint32_t const index) const
+    {
+        std::size_t const word = index / WordBits;
+
+        return word < _words.size() && (_words[word] >> (index % WordBits)) & 1u;
+    }
+
+    template<typename Visitor>
+    void forEach(Visitor &&visitor) const
+    {
+        for (std::size_t word = 0; word < _words.size(); ++word) {
+            std::uint64_t bits = _words[word];
+
+            for (std::uint32_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+                if (bits & 1u)
+                    visitor(static_cast<std::uint32_t>(word * WordBits + bit));
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t WordBits = 64;
+
+    std::vector<std::uint64_t> _words;
+};
+
+/**
+ * Memoizes upstream and downstream reachability over a `TopologicalOrder`.
+ *
+ * Every query result is kept as a `NodeBitSet` keyed by the start node,
+ * the direction and the depth limit. The bits address dense slots handed
+ * out to the nodes on their first appearance in a result and recycled
+ * once the node is removed, so a result costs one bit per cached node
+ * whatever the node ids are. At most `capacity()` results are kept, the
+ * least recently used one is dropped first.
+ *
+ * When an edge `from -> to` changes, only the downstream results
+ * containing `from` and the upstream results containing `to` are dropped;
+ * all other results stay valid.
+ */
+class NODE_EDITOR_PUBLIC ReachabilityCache
+{
+public:
+    enum class Direction { Upstream, Downstream };
+
+    static constexpr unsigned int UnlimitedDepth = std::numeric_limits<unsigned int>::max();
+
+public:
+    explicit ReachabilityCache(TopologicalOrder const &graph)
+        : _graph(graph)
+    {}
+
+    /**
+   * @returns the nodes reachable from `nodeId` in the given direction
+   * through at most `depth` edges. The start node itself is not included.
+   */
+    std::unordered_set<NodeId> reachable(NodeId const nodeId,
+                                         Direction const direction,
+                                         unsigned int const depth = UnlimitedDepth) const;
+
+    /// Checks whether `target` is reachable from `nodeId`, @see reachable.
+    bool contains(NodeId const nodeId,
+                  Direction const direction,
+                  NodeId const target,
+                  unsigned int const depth = UnlimitedDepth) const;
+
+    /**
+   * Adds `nodeId` and the nodes reachable from it to `nodes`, so several
+   * queries can be merged and tested with `contains(nodes, nodeId)`. The
+   * set stays valid until one of its nodes is invalidated.
+   */
+    void collect(NodeId const nodeId, Direction const direction, NodeBitSet &nodes) const;
+
+    /// Checks whether a set filled by `collect` holds the node.
+    bool contains(NodeBitSet const &nodes, NodeId const nodeId) const;
+
+    /// Must be called after an edge between the two nodes was added or removed.
+    void invalidateEdge(NodeId const from, NodeId const to);
+
+    /// Must be called after the node was removed from the graph.
+    void invalidateNode(NodeId const nodeId);
+
+    void clear();
+
+    std::size_t capacity() const { return _capacity; }
+
+    /// Bounds the number of cached results, 256 by default.
+    void setCapacity(std::size_t const capacity);
+
+    std::size_t size() const { return _entries.size(); }
+
+private:
+    struct Entry
+    {
+        std::uint64_t key;
+        NodeId nodeId;
+        Direction direction;
+        NodeBitSet nodes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static std::uint64_t key(NodeId const nodeId, Direction const direction, unsigned int depth);
+
+    /// Finds or computes the result and marks it as the most recently used.
+    Entry const &lookup(NodeId const nodeId,
+                        Direction const direction,
+                        unsigned int const depth) const;
+
+    void erase(EntryList::iterator const it) const;
+
+    /// @returns the slot of the node, allocating a free one when needed.
+    std::uint32_t slotOf(NodeId const nodeId) const;
+
+    /// @returns false when the node has no slot, i.e. is in no result.
+    bool findSlot(NodeId const nodeId, std::uint32_t &slot) const;
+
+private:
+    TopologicalOrder const &_graph;
+
+    std::size_t _capacity = 256;
+
+    /// Most recently used results first.
+    mutable EntryList _entries;
+
+    mutable std::unordered_map<std::uint64_t, EntryList::iterator> _index;
+
+    mutable std::unordered_map<NodeId, std::uint32_t> _slots;
+
+    /// Node of every slot, InvalidNodeId for the free ones.
+    mutable std::vector<NodeId> _slotNodes;
+
+    mutable std::vector<std::uint32_t> _freeSlots;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "NodeData.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace QtNodes {
+
+/**
+ * Immutable array of values shared between its copies.
+ *
+ * Copying the buffer only copies a reference, so bulk data handed to any
+ * number of consumers lives in one allocation. The mutable accessors
+ * detach first: a buffer sharing its storage gets a private copy at that
+ * point and the other copies keep seeing the original values.
+ *
+ * The storage is reference counted explicitly, the count is read with
+ * acquire ordering so a buffer seen as unshared also sees every write
+ * made through the copies released on the other threads. Every storage
+ * carries a generation, unique among the buffers of the type and renewed
+ * on every mutable access.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class SharedBuffer
+{
+public:
+    using Storage = std::vector<T, Allocator>;
+
+    SharedBuffer() = default;
+
+    explicit SharedBuffer(std::size_t const size, T const &value = T())
+        : _block(new Block(Storage(size, value)))
+    {}
+
+    explicit SharedBuffer(Storage values)
+        : _block(new Block(std::move(values)))
+    {}
+
+    SharedBuffer(SharedBuffer const &other)
+        : _block(other._block)
+    {
+        if (_block)
+            _block->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedBuffer(SharedBuffer &&other) noexcept
+        : _block(other._block)
+    {
+        other._block = nullptr;
+    }
+
+    SharedBuffer &operator=(SharedBuffer other) noexcept
+    {
+        std::swap(_block, other._block);
+
+        return *this;
+    }
+
+    ~SharedBuffer() { release(); }
+
+    std::size_t size() const { return _block ? _block->values.size() : 0; }
+
+    bool empty() const { return size() == 0; }
+
+    T const *data() const { return _block ? _block->values.data() : nullptr; }
+
+    T const *begin() const { return data(); }
+
+    T const *end() const { return data() + size(); }
+
+    T const &operator[](std::size_t const index) const { return _block->values[index]; }
+
+    /// Checks whether another buffer refers to the same storage.
+    bool isShared() const
+    {
+        return _block && _block->references.load(std::memory_order_acquire) > 1;
+    }
+
+    bool sharesStorageWith(SharedBuffer const &other) const { return _block == other._block; }
+
+    /// Changes with every mutable access, 0 for a buffer without storage.
+    std::uint64_t generation() const { return _block ? _block->generation : 0; }
+
+    /// Copy-on-write access to the values.
+    T *mutableData()
+    {
+        if (!_block)
+            return nullptr;
+
+        return mutableStorage().data();
+    }
+
+    /// Copy-on-write access to the whole storage, e.g. for resizing.
+    Storage &mutableStorage()
+    {
+        if (!_block)
+            _block = new Block(Storage());
+
+        detach();
+
+        _block->generation = nextGeneration();
+
+        return _block->values;
+    }
+
+    /// Makes the storage private to this buffer.
+    void detach()
+    {
+        if (!isShared())
+            return;
+
+        Block *copy = new Block(_block->values);
+
+        release();
+
+        _block = copy;
+    }
+
+private:
+    struct Block
+    {
+        explicit Block(Storage values)
+            : values(std::move(values))
+        {}
+
+        std::atomic<std::size_t> references{1};
+
+        std::uint64_t generation = nextGeneration();
+
+        Storage values;
+    };
+
+    static std::uint64_t nextGeneration()
+    {
+        static std::atomic<std::uint64_t> generations{0};
+
+        return generations.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    void release()
+    {
+        // The last owner must see all the writes of the others before
+        // destroying the values.
+        if (_block && _block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete _block;
+
+        _block = nullptr;
+    }
+
+private:
+    Block *_block = nullptr;
+};
+
+/**
+ * Base for NodeData types carrying a SharedBuffer.
+ *
+ * Two data objects sharing the storage in the same generation are equal,
+ * which lets the propagation stop at nodes passing their buffers through
+ * unchanged; the contents are never compared element by element. The
+ * generation is also the revision, so a node modifying its buffer in
+ * place and emitting the same data object again is not cut off.
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+class BufferData : public NodeData
+{
+public:
+    using Buffer = SharedBuffer<T, Allocator>;
+
+    BufferData() = default;
+
+    explicit BufferData(Buffer buffer)
+        : _buffer(std::move(buffer))
+    {}
+
+    Buffer const &buffer() const { return _buffer; }
+
+    bool equals(NodeData const &other) const override
+    {
+        auto data = dynamic_cast<BufferData const *>(&other);
+
+        return data && data->_buffer.sharesStorageWith(_buffer)
+               && data->_buffer.generation() == _buffer.generation() && sameType(other);
+    }
+
+    std::uint64_t revision() const override { return _buffer.generation(); }
+
+    std::size_t byteSize() const override { return sizeof(*this) + _buffer.size() * sizeof(T); }
+
+protected:
+    Buffer _buffer;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Definitions.hpp"
+#include "Export.hpp"
+#include "FunctionRef.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace QtNodes {
+
+/**
+ * Maintains a topological order of a directed acyclic node graph.
+ *
+ * The class implements the dynamic algorithm of Pearce and Kelly. Every
+ * node carries an integer rank, an edge `from -> to` is consistent when
+ * `rank(from) < rank(to)`. Inserting an inconsistent edge only explores
+ * the nodes ranked between the two endpoints and permutes the ranks
+ * inside that region, so the cost depends on the affected part of the
+ * graph rather than on its total size. The same bounded search answers
+ * whether an edge would close a cycle.
+ *
+ * Several connections between the same pair of nodes are folded into a
+ * single edge with a multiplicity counter.
+ */
+class NODE_EDITOR_PUBLIC TopologicalOrder
+{
+public:
+    /// Appends the node at the end of the order.
+    void addNode(NodeId const nodeId);
+
+    /// Removes the node together with all its edges.
+    void removeNode(NodeId const nodeId);
+
+    bool contains(NodeId const nodeId) const;
+
+    /// Inserts the edge keeping the order consistent.
+    /**
+   * @returns false without modifying anything when the edge would create
+   * a cycle or when either node is unknown.
+   */
+    bool addEdge(NodeId const from, NodeId const to);
+
+    /// Drops one occurrence of the edge.
+    void removeEdge(NodeId const from, NodeId const to);
+
+    /// Checks whether a path `to ~> from` exists, self loops included.
+    bool wouldCreateCycle(NodeId const from, NodeId const to) const;
+
+    /// @returns the rank of the node, upstream nodes have lower ranks.
+    std::size_t rank(NodeId const nodeId) const;
+
+    using NodeVisitor = FunctionRef<void(NodeId const)>;
+
+    /// Visits every node directly fed by `nodeId`, once per node.
+    void forEachSuccessor(NodeId const nodeId, NodeVisitor const visitor) const;
+
+    /// Visits every node directly feeding `nodeId`, once per node.
+    void forEachPredecessor(NodeId const nodeId, NodeVisitor const visitor) const;
+
+    void clear();
+
+private:
+    using Adjacency = std::unordered_map<NodeId, std::unordered_map<NodeId, unsigned int>>;
+
+    /**
+   * Collects the nodes reachable from `start` along `adjacency` whose rank
+   * lies strictly between `lowerBound` and `upperBound`.
+   *
+   * @returns false as soon as `target` is reached.
+   */
+    bool collectRegion(NodeId const start,
+                       NodeId const target,
+                       Adjacency const &adjacency,
+                       std::size_t const lowerBound,
+                       std::size_t const upperBound,
+                       std::vector<NodeId> &region) const;
+
+    /// Reassigns the ranks of the affected region, @see addEdge.
+    void reorder(std::vector<NodeId> &backward, std::vector<NodeId> &forward);
+
+private:
+    std::unordered_map<NodeId, std::size_t> _ranks;
+
+    std::size_t _nextRank = 0;
+
+    Adjacency _successors;
+
+    Adjacency _predecessors;
+};
+
+} // namespace QtNodes
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "NodeData.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace QtNodes {
+
+using SharedNodeData = std::shared_ptr<NodeData>;
+
+/// Turns the data of an output port into the type of the connected input port.
+/**
+ * Called with non-null data only. A converter may return its argument or
+ * an aliasing `shared_ptr` when the target type can view the payload of
+ * the source without copying it.
+ */
+using TypeConverter = std::function<SharedNodeData(SharedNodeData)>;
+
+/// The pair (output type, input type) the converter is registered for.
+using TypeConverterId = std::pair<NodeDataType, NodeDataType>;
+
+} // namespace QtNodes
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Export.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace QtNodes {
+
+/**
+ * Fixed set of worker threads with one task deque per worker.
+ *
+ * A worker takes tasks from the back of its own deque and, once it runs
+ * dry, steals from the front of the other deques. Tasks submitted from a
+ * worker thread go to the deque of that worker, so the work spawned by a
+ * task tends to stay on the same core; tasks submitted from any other
+ * thread are spread round-robin.
+ *
+ * The destructor runs all the queued tasks to completion before joining
+ * the workers.
+ */
+class NODE_EDITOR_PUBLIC WorkStealingThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+public:
+    /// A zero `threadCount` picks the number of hardware threads.
+    explicit WorkStealingThreadPool(unsigned int threadCount = 0);
+
+    ~WorkStealingThreadPool();
+
+    WorkStealingThreadPool(WorkStealingThreadPool const &) = delete;
+
+    WorkStealingThreadPool &operator=(WorkStealingThreadPool const &) = delete;
+
+public:
+    void submit(Task task);
+
+    unsigned int threadCount() const { return static_cast<unsigned int>(_workers.size()); }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void run(std::size_t const workerIndex);
+
+    bool popTask(std::size_t const workerIndex, Task &task);
+
+private:
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::mutex _sleepMutex;
+
+    std::condition_variable _wakeUp;
+
+    /// Number of queued tasks not yet taken by a worker. It is counted
+    /// after the push and may drop below zero for a moment.
+    std::atomic<std::ptrdiff_t> _pending{0};
+
+    std::atomic<std::size_t> _nextWorker{0};
+
+    bool _stopping = false;
+};
+
+} // namespace QtNodes
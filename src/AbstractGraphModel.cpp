@@ -2,8 +2,141 @@
 
 #include <QtNodes/ConnectionIdUtils>
 
+#include <QtCore/QJsonDocument>
+#include <QtCore/QPointF>
+#include <QtCore/QSize>
+#include <QtWidgets/QWidget>
+
+#include <algorithm>
+
 namespace QtNodes {
 
+namespace {
+
+/// Drops the items deleted within the batch, keeping the creation order.
+template<typename Id>
+std::vector<Id> takeCreated(std::vector<Id> &created, std::unordered_set<Id> &pending)
+{
+    std::vector<Id> result;
+    result.reserve(pending.size());
+
+    for (Id const &id : created) {
+        // Erasing also skips an item created again after its deletion.
+        if (pending.erase(id) > 0)
+            result.push_back(id);
+    }
+
+    created.clear();
+    pending.clear();
+
+    return result;
+}
+
+} // namespace
+
+void AbstractGraphModel::forEachNode(NodeVisitor const visitor) const
+{
+    for (NodeId const nodeId : allNodeIds()) {
+        visitor(nodeId);
+    }
+}
+
+void AbstractGraphModel::forEachConnection(NodeId const nodeId,
+                                           ConnectionVisitor const visitor) const
+{
+    for (auto const &connectionId : allConnectionIds(nodeId)) {
+        visitor(connectionId);
+    }
+}
+
+void AbstractGraphModel::forEachConnection(NodeId const nodeId,
+                                           PortType const portType,
+                                           PortIndex const portIndex,
+                                           ConnectionVisitor const visitor) const
+{
+    for (auto const &connectionId : connections(nodeId, portType, portIndex)) {
+        visitor(connectionId);
+    }
+}
+
+std::size_t AbstractGraphModel::connectionCount(NodeId const nodeId,
+                                                PortType const portType,
+                                                PortIndex const portIndex) const
+{
+    std::size_t count = 0;
+
+    forEachConnection(nodeId, portType, portIndex, [&count](ConnectionId const &) { ++count; });
+
+    return count;
+}
+
+QPointF AbstractGraphModel::nodePosition(NodeId const nodeId) const
+{
+    return nodeData<QPointF>(nodeId, NodeRole::Position);
+}
+
+QSize AbstractGraphModel::nodeSize(NodeId const nodeId) const
+{
+    return nodeData<QSize>(nodeId, NodeRole::Size);
+}
+
+bool AbstractGraphModel::nodeCaptionVisible(NodeId const nodeId) const
+{
+    return nodeData<bool>(nodeId, NodeRole::CaptionVisible);
+}
+
+QString AbstractGraphModel::nodeCaption(NodeId const nodeId) const
+{
+    return nodeData<QString>(nodeId, NodeRole::Caption);
+}
+
+QWidget *AbstractGraphModel::nodeWidget(NodeId const nodeId) const
+{
+    return nodeData<QWidget *>(nodeId, NodeRole::Widget);
+}
+
+NodeStyle AbstractGraphModel::nodeStyle(NodeId const nodeId) const
+{
+    QJsonDocument const json = QJsonDocument::fromVariant(nodeData(nodeId, NodeRole::Style));
+
+    return NodeStyle(json.object());
+}
+
+PortCount AbstractGraphModel::portCount(NodeId const nodeId, PortType const portType) const
+{
+    auto portCountRole = portType == PortType::In ? NodeRole::InPortCount : NodeRole::OutPortCount;
+
+    return nodeData(nodeId, portCountRole).toUInt();
+}
+
+NodeDataType AbstractGraphModel::portDataType(NodeId const nodeId,
+                                              PortType const portType,
+                                              PortIndex const portIndex) const
+{
+    return portData<NodeDataType>(nodeId, portType, portIndex, PortRole::DataType);
+}
+
+bool AbstractGraphModel::portCaptionVisible(NodeId const nodeId,
+                                            PortType const portType,
+                                            PortIndex const portIndex) const
+{
+    return portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible);
+}
+
+QString AbstractGraphModel::portCaption(NodeId const nodeId,
+                                        PortType const portType,
+                                        PortIndex const portIndex) const
+{
+    return portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+}
+
+ConnectionPolicy AbstractGraphModel::portConnectionPolicy(NodeId const nodeId,
+                                                         PortType const portType,
+                                                         PortIndex const portIndex) const
+{
+    return portData<ConnectionPolicy>(nodeId, portType, portIndex, PortRole::ConnectionPolicyRole);
+}
+
 void AbstractGraphModel::portsAboutToBeDeleted(NodeId const nodeId,
                                                PortType const portType,
                                                PortIndex const first,
@@ -11,9 +144,7 @@ void AbstractGraphModel::portsAboutToBeDeleted(NodeId const nodeId,
 {
     _shiftedByDynamicPortsConnections.clear();
 
-    auto portCountRole = portType == PortType::In ? NodeRole::InPortCount : NodeRole::OutPortCount;
-
-    unsigned int portCount = nodeData(nodeId, portCountRole).toUInt();
+    unsigned int portCount = this->portCount(nodeId, portType);
 
     if (first > portCount - 1)
         return;
@@ -65,9 +196,7 @@ void AbstractGraphModel::portsAboutToBeInserted(NodeId const nodeId,
 {
     _shiftedByDynamicPortsConnections.clear();
 
-    auto portCountRole = portType == PortType::In ? NodeRole::InPortCount : NodeRole::OutPortCount;
-
-    unsigned int portCount = nodeData(nodeId, portCountRole).toUInt();
+    unsigned int portCount = this->portCount(nodeId, portType);
 
     if (first > portCount)
         return;
@@ -102,4 +231,81 @@ void AbstractGraphModel::portsInserted()
     _shiftedByDynamicPortsConnections.clear();
 }
 
+void AbstractGraphModel::beginBatch()
+{
+    ++_batchDepth;
+}
+
+void AbstractGraphModel::endBatch()
+{
+    if (_batchDepth == 0 || --_batchDepth > 0)
+        return;
+
+    // Slots may start a new batch, so the queues are released first.
+    std::vector<ConnectionId> deletedConnections = std::move(_batchDeletedConnections);
+    std::vector<NodeId> deletedNodes = std::move(_batchDeletedNodes);
+    std::vector<NodeId> createdNodes = takeCreated(_batchCreatedNodes, _batchPendingNodes);
+    std::vector<ConnectionId> createdConnections = takeCreated(_batchCreatedConnections,
+                                                               _batchPendingConnections);
+
+    _batchDeletedConnections.clear();
+    _batchDeletedNodes.clear();
+
+    if (!deletedConnections.empty())
+        Q_EMIT connectionsDeleted(deletedConnections);
+
+    if (!deletedNodes.empty())
+        Q_EMIT nodesDeleted(deletedNodes);
+
+    if (!createdNodes.empty())
+        Q_EMIT nodesCreated(createdNodes);
+
+    if (!createdConnections.empty())
+        Q_EMIT connectionsCreated(createdConnections);
+}
+
+void AbstractGraphModel::notifyNodeCreated(NodeId const nodeId)
+{
+    if (!batchInProgress()) {
+        Q_EMIT nodeCreated(nodeId);
+        return;
+    }
+
+    if (_batchPendingNodes.insert(nodeId).second)
+        _batchCreatedNodes.push_back(nodeId);
+}
+
+void AbstractGraphModel::notifyNodeDeleted(NodeId const nodeId)
+{
+    if (!batchInProgress()) {
+        Q_EMIT nodeDeleted(nodeId);
+        return;
+    }
+
+    if (_batchPendingNodes.erase(nodeId) == 0)
+        _batchDeletedNodes.push_back(nodeId);
+}
+
+void AbstractGraphModel::notifyConnectionCreated(ConnectionId const connectionId)
+{
+    if (!batchInProgress()) {
+        Q_EMIT connectionCreated(connectionId);
+        return;
+    }
+
+    if (_batchPendingConnections.insert(connectionId).second)
+        _batchCreatedConnections.push_back(connectionId);
+}
+
+void AbstractGraphModel::notifyConnectionDeleted(ConnectionId const connectionId)
+{
+    if (!batchInProgress()) {
+        Q_EMIT connectionDeleted(connectionId);
+        return;
+    }
+
+    if (_batchPendingConnections.erase(connectionId) == 0)
+        _batchDeletedConnections.push_back(connectionId);
+}
+
 } // namespace QtNodes
@@ -64,6 +64,26 @@ BasicGraphicsScene::BasicGraphicsScene(AbstractGraphModel &graphModel, QObject *
             this,
             &BasicGraphicsScene::onNodeDeleted);
 
+    connect(&_graphModel,
+            &AbstractGraphModel::connectionsCreated,
+            this,
+            &BasicGraphicsScene::onConnectionsCreated);
+
+    connect(&_graphModel,
+            &AbstractGraphModel::connectionsDeleted,
+            this,
+            &BasicGraphicsScene::onConnectionsDeleted);
+
+    connect(&_graphModel,
+            &AbstractGraphModel::nodesCreated,
+            this,
+            &BasicGraphicsScene::onNodesCreated);
+
+    connect(&_graphModel,
+            &AbstractGraphModel::nodesDeleted,
+            this,
+            &BasicGraphicsScene::onNodesDeleted);
+
     connect(&_graphModel,
             &AbstractGraphModel::nodePositionUpdated,
             this,
@@ -74,6 +94,11 @@ BasicGraphicsScene::BasicGraphicsScene(AbstractGraphModel &graphModel, QObject *
             this,
             &BasicGraphicsScene::onNodeUpdated);
 
+    connect(&_graphModel,
+            &AbstractGraphModel::nodeStyleUpdated,
+            this,
+            &BasicGraphicsScene::onNodeStyleUpdated);
+
     connect(this, &BasicGraphicsScene::nodeClicked, this, &BasicGraphicsScene::onNodeClicked);
 
     connect(&_graphModel, &AbstractGraphModel::modelReset, this, &BasicGraphicsScene::onModelReset);
@@ -147,6 +172,8 @@ void BasicGraphicsScene::clearScene()
 {
     auto const &allNodeIds = graphModel().allNodeIds();
 
+    GraphModelBatch batch(graphModel());
+
     for (auto nodeId : allNodeIds) {
         graphModel().deleteNode(nodeId);
     }
@@ -201,26 +228,26 @@ QMenu *BasicGraphicsScene::createSceneMenu(QPointF const scenePos)
 
 void BasicGraphicsScene::traverseGraphAndPopulateGraphicsObjects()
 {
-    auto allNodeIds = _graphModel.allNodeIds();
-
     // First create all the nodes.
-    for (NodeId const nodeId : allNodeIds) {
+    _graphModel.forEachNode([this](NodeId const nodeId) {
         _nodeGraphicsObjects[nodeId] = std::make_unique<NodeGraphicsObject>(*this, nodeId);
-    }
+    });
 
     // Then for each node check output connections and insert them.
-    for (NodeId const nodeId : allNodeIds) {
-        auto nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    _graphModel.forEachNode([this](NodeId const nodeId) {
+        PortCount const nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
         for (PortIndex index = 0; index < nOutPorts; ++index) {
-            auto const &outConnectionIds = _graphModel.connections(nodeId, PortType::Out, index);
-
-            for (auto cid : outConnectionIds) {
-                _connectionGraphicsObjects[cid] = std::make_unique<ConnectionGraphicsObject>(*this,
-                                                                                             cid);
-            }
+            _graphModel.forEachConnection(nodeId,
+                                          PortType::Out,
+                                          index,
+                                          [this](ConnectionId const &cid) {
+                                              _connectionGraphicsObjects[cid]
+                                                  = std::make_unique<ConnectionGraphicsObject>(*this,
+                                                                                               cid);
+                                          });
         }
-    }
+    });
 }
 
 void BasicGraphicsScene::updateAttachedNodes(ConnectionId const connectionId,
@@ -279,11 +306,74 @@ void BasicGraphicsScene::onNodeCreated(NodeId const nodeId)
     Q_EMIT modified(this);
 }
 
+void BasicGraphicsScene::onNodesCreated(std::vector<NodeId> const &nodeIds)
+{
+    for (NodeId const nodeId : nodeIds) {
+        _nodeGraphicsObjects[nodeId] = std::make_unique<NodeGraphicsObject>(*this, nodeId);
+    }
+
+    Q_EMIT modified(this);
+}
+
+void BasicGraphicsScene::onNodesDeleted(std::vector<NodeId> const &nodeIds)
+{
+    for (NodeId const nodeId : nodeIds) {
+        _nodeGraphicsObjects.erase(nodeId);
+    }
+
+    Q_EMIT modified(this);
+}
+
+void BasicGraphicsScene::onConnectionsCreated(std::vector<ConnectionId> const &connectionIds)
+{
+    std::unordered_set<NodeId> attachedNodes;
+
+    for (ConnectionId const &connectionId : connectionIds) {
+        _connectionGraphicsObjects[connectionId]
+            = std::make_unique<ConnectionGraphicsObject>(*this, connectionId);
+
+        attachedNodes.insert(connectionId.outNodeId);
+        attachedNodes.insert(connectionId.inNodeId);
+    }
+
+    for (NodeId const nodeId : attachedNodes) {
+        if (auto node = nodeGraphicsObject(nodeId))
+            node->update();
+    }
+
+    Q_EMIT modified(this);
+}
+
+void BasicGraphicsScene::onConnectionsDeleted(std::vector<ConnectionId> const &connectionIds)
+{
+    std::unordered_set<NodeId> attachedNodes;
+
+    for (ConnectionId const &connectionId : connectionIds) {
+        _connectionGraphicsObjects.erase(connectionId);
+
+        if (_draftConnection && _draftConnection->connectionId() == connectionId) {
+            _draftConnection.reset();
+        }
+
+        attachedNodes.insert(connectionId.outNodeId);
+        attachedNodes.insert(connectionId.inNodeId);
+    }
+
+    // Nodes deleted within the same batch are still present here and
+    // receive a harmless repaint request.
+    for (NodeId const nodeId : attachedNodes) {
+        if (auto node = nodeGraphicsObject(nodeId))
+            node->update();
+    }
+
+    Q_EMIT modified(this);
+}
+
 void BasicGraphicsScene::onNodePositionUpdated(NodeId const nodeId)
 {
     auto node = nodeGraphicsObject(nodeId);
     if (node) {
-        node->setPos(_graphModel.nodeData(nodeId, NodeRole::Position).value<QPointF>());
+        node->setPos(_graphModel.nodePosition(nodeId));
         node->update();
         _nodeDrag = true;
     }
@@ -304,10 +394,20 @@ void BasicGraphicsScene::onNodeUpdated(NodeId const nodeId)
     }
 }
 
+void BasicGraphicsScene::onNodeStyleUpdated(NodeId const nodeId)
+{
+    auto node = nodeGraphicsObject(nodeId);
+
+    if (node) {
+        node->updateNodeStyle();
+        node->update();
+    }
+}
+
 void BasicGraphicsScene::onNodeClicked(NodeId const nodeId)
 {
     if (_nodeDrag) {
-        Q_EMIT nodeMoved(nodeId, _graphModel.nodeData(nodeId, NodeRole::Position).value<QPointF>());
+        Q_EMIT nodeMoved(nodeId, _graphModel.nodePosition(nodeId));
         Q_EMIT modified(this);
     }
     _nodeDrag = false;
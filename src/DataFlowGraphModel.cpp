@@ -2,20 +2,87 @@
 #include "ConnectionIdHash.hpp"
 
 #include <QJsonArray>
+#include <QtCore/QDebug>
+#include <QtCore/QMetaObject>
+#include <QtCore/QSignalBlocker>
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <string>
 
 namespace QtNodes {
 
+namespace {
+
+/// Collects the outputs a node emits while it is computing on the current thread.
+struct OutputCapture
+{
+    NodeId nodeId;
+    NodeDelegateModel *model;
+    NodeDelegateModel::PortDataList outputs;
+};
+
+thread_local OutputCapture *outputCapture = nullptr;
+
+/// Runs `call` with the outputs of the node captured instead of propagated.
+template<typename Call>
+NodeDelegateModel::PortDataList captureOutputs(NodeId const nodeId,
+                                               NodeDelegateModel *model,
+                                               Call &&call)
+{
+    OutputCapture capture{nodeId, model, {}};
+
+    OutputCapture *const previous = outputCapture;
+
+    outputCapture = &capture;
+    call();
+    outputCapture = previous;
+
+    return std::move(capture.outputs);
+}
+
+ExecutionPlan::Instruction::Opcode toOpcode(FusableExpression::Operation const operation)
+{
+    using Opcode = ExecutionPlan::Instruction::Opcode;
+
+    switch (operation) {
+    case FusableExpression::Operation::Subtract:
+        return Opcode::Subtract;
+
+    case FusableExpression::Operation::Multiply:
+        return Opcode::Multiply;
+
+    case FusableExpression::Operation::Divide:
+        return Opcode::Divide;
+
+    default:
+        return Opcode::Add;
+    }
+}
+
+} // namespace
+
 DataFlowGraphModel::DataFlowGraphModel(std::shared_ptr<NodeDelegateModelRegistry> registry)
     : _registry(std::move(registry))
     , _nextNodeId{0}
-{}
+{
+    _coalescingTimer.setSingleShot(true);
+
+    connect(&_coalescingTimer,
+            &QTimer::timeout,
+            this,
+            &DataFlowGraphModel::flushCoalescedUpdates);
+}
 
 std::unordered_set<NodeId> DataFlowGraphModel::allNodeIds() const
 {
     std::unordered_set<NodeId> nodeIds;
-    for_each(_models.begin(), _models.end(), [&nodeIds](auto const &p) { nodeIds.insert(p.first); });
+    nodeIds.reserve(_nodes.size());
+
+    for (auto const &entry : _nodes) {
+        nodeIds.insert(entry.nodeId);
+    }
 
     return nodeIds;
 }
@@ -24,12 +91,8 @@ std::unordered_set<ConnectionId> DataFlowGraphModel::allConnectionIds(NodeId con
 {
     std::unordered_set<ConnectionId> result;
 
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
-                 std::inserter(result, std::end(result)),
-                 [&nodeId](ConnectionId const &cid) {
-                     return cid.inNodeId == nodeId || cid.outNodeId == nodeId;
-                 });
+    forEachConnection(nodeId,
+                      [&result](ConnectionId const &connectionId) { result.insert(connectionId); });
 
     return result;
 }
@@ -38,17 +101,75 @@ std::unordered_set<ConnectionId> DataFlowGraphModel::connections(NodeId nodeId,
                                                                  PortType portType,
                                                                  PortIndex portIndex) const
 {
-    std::unordered_set<ConnectionId> result;
+    auto it = _portConnections.find(PortKey{nodeId, portType, portIndex});
 
-    std::copy_if(_connectivity.begin(),
-                 _connectivity.end(),
-                 std::inserter(result, std::end(result)),
-                 [&portType, &portIndex, &nodeId](ConnectionId const &cid) {
-                     return (getNodeId(portType, cid) == nodeId
-                             && getPortIndex(portType, cid) == portIndex);
-                 });
+    if (it == _portConnections.end())
+        return std::unordered_set<ConnectionId>();
 
-    return result;
+    return it->second;
+}
+
+void DataFlowGraphModel::forEachNode(NodeVisitor const visitor) const
+{
+    for (auto const &entry : _nodes) {
+        visitor(entry.nodeId);
+    }
+}
+
+void DataFlowGraphModel::forEachConnection(NodeId const nodeId,
+                                           ConnectionVisitor const visitor) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    for (PortType portType : {PortType::In, PortType::Out}) {
+        unsigned int const nPorts = record->model->nPorts(portType);
+
+        for (PortIndex portIndex = 0; portIndex < nPorts; ++portIndex) {
+            forEachConnection(nodeId, portType, portIndex, visitor);
+        }
+    }
+}
+
+void DataFlowGraphModel::forEachConnection(NodeId const nodeId,
+                                           PortType const portType,
+                                           PortIndex const portIndex,
+                                           ConnectionVisitor const visitor) const
+{
+    auto it = _portConnections.find(PortKey{nodeId, portType, portIndex});
+    if (it == _portConnections.end())
+        return;
+
+    for (auto const &connectionId : it->second) {
+        visitor(connectionId);
+    }
+}
+
+std::size_t DataFlowGraphModel::connectionCount(NodeId const nodeId,
+                                                PortType const portType,
+                                                PortIndex const portIndex) const
+{
+    auto it = _portConnections.find(PortKey{nodeId, portType, portIndex});
+
+    return (it != _portConnections.end()) ? it->second.size() : 0;
+}
+
+std::unordered_set<NodeId> DataFlowGraphModel::upstreamOf(NodeId const nodeId,
+                                                      unsigned int const depth) const
+{
+    return _reachability.reachable(nodeId, ReachabilityCache::Direction::Upstream, depth);
+}
+
+std::unordered_set<NodeId> DataFlowGraphModel::downstreamOf(NodeId const nodeId,
+                                                        unsigned int const depth) const
+{
+    return _reachability.reachable(nodeId, ReachabilityCache::Direction::Downstream, depth);
+}
+
+bool DataFlowGraphModel::reaches(NodeId const from, NodeId const to) const
+{
+    return _reachability.contains(from, ReachabilityCache::Direction::Downstream, to);
 }
 
 bool DataFlowGraphModel::connectionExists(ConnectionId const connectionId) const
@@ -63,39 +184,11 @@ NodeId DataFlowGraphModel::addNode(QString const nodeType)
     if (model) {
         NodeId newId = newNodeId();
 
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [newId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(newId, portIndex);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeDeleted,
-                this,
-                [newId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeDeleted(newId, portType, first, last);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsDeleted,
-                this,
-                &DataFlowGraphModel::portsDeleted);
-
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeInserted,
-                this,
-                [newId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeInserted(newId, portType, first, last);
-                });
+        attachDelegate(newId, std::move(model));
 
-        connect(model.get(),
-                &NodeDelegateModel::portsInserted,
-                this,
-                &DataFlowGraphModel::portsInserted);
+        updatePortDataTypes(newId);
 
-        _models[newId] = std::move(model);
-
-        Q_EMIT nodeCreated(newId);
+        notifyNodeCreated(newId);
 
         return newId;
     }
@@ -103,91 +196,207 @@ NodeId DataFlowGraphModel::addNode(QString const nodeType)
     return InvalidNodeId;
 }
 
+void DataFlowGraphModel::attachDelegate(NodeId const nodeId,
+                                        std::unique_ptr<NodeDelegateModel> model)
+{
+    connect(model.get(),
+            &NodeDelegateModel::dataUpdated,
+            [nodeId, this](PortIndex const portIndex) { onOutPortDataUpdated(nodeId, portIndex); });
+
+    connect(model.get(),
+            &NodeDelegateModel::dataInvalidated,
+            [nodeId, this](PortIndex const portIndex) {
+                onOutPortDataInvalidated(nodeId, portIndex);
+            });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsAboutToBeDeleted,
+            this,
+            [nodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
+                portsAboutToBeDeleted(nodeId, portType, first, last);
+            });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsDeleted,
+            this,
+            [nodeId, this]() { updatePortDataTypes(nodeId); });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsDeleted,
+            this,
+            &DataFlowGraphModel::portsDeleted);
+
+    connect(model.get(),
+            &NodeDelegateModel::portsAboutToBeInserted,
+            this,
+            [nodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
+                portsAboutToBeInserted(nodeId, portType, first, last);
+            });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsInserted,
+            this,
+            [nodeId, this]() { updatePortDataTypes(nodeId); });
+
+    connect(model.get(),
+            &NodeDelegateModel::portsInserted,
+            this,
+            &DataFlowGraphModel::portsInserted);
+
+    connect(model.get(),
+            &NodeDelegateModel::nodeStyleUpdated,
+            this,
+            [nodeId, this]() { Q_EMIT nodeStyleUpdated(nodeId); });
+
+    NodeRecord record;
+    record.flags = model->resizable() ? NodeFlag::Resizable : NodeFlag::NoFlags;
+    record.model = std::move(model);
+
+    _nodes.insert(nodeId, std::move(record));
+
+    _topology.addNode(nodeId);
+}
+
 bool DataFlowGraphModel::connectionPossible(ConnectionId const connectionId) const
 {
-    auto getDataType = [&](PortType const portType) {
-        return portData(getNodeId(portType, connectionId),
-                        portType,
-                        getPortIndex(portType, connectionId),
-                        PortRole::DataType)
-            .value<NodeDataType>();
-    };
+    NodeRecord const *outRecord = _nodes.find(connectionId.outNodeId);
+    NodeRecord const *inRecord = _nodes.find(connectionId.inNodeId);
+
+    if (!outRecord || !inRecord)
+        return false;
+
+    if (connectionId.outPortIndex >= outRecord->outTypes.size()
+        || connectionId.inPortIndex >= inRecord->inTypes.size())
+        return false;
+
+    if (!_registry->dataTypesCompatible(outRecord->outTypes[connectionId.outPortIndex],
+                                        inRecord->inTypes[connectionId.inPortIndex]))
+        return false;
+
+    // The data propagation would never terminate on a cycle.
+    if (_topology.wouldCreateCycle(connectionId.outNodeId, connectionId.inNodeId))
+        return false;
 
-    auto portVacant = [&](PortType const portType) {
+    auto portVacant = [&](NodeRecord const *record, PortType const portType) {
         NodeId const nodeId = getNodeId(portType, connectionId);
         PortIndex const portIndex = getPortIndex(portType, connectionId);
-        auto const connected = connections(nodeId, portType, portIndex);
 
-        auto policy = portData(nodeId, portType, portIndex, PortRole::ConnectionPolicyRole)
-                          .value<ConnectionPolicy>();
+        if (connectionCount(nodeId, portType, portIndex) == 0)
+            return true;
 
-        return connected.empty() || (policy == ConnectionPolicy::Many);
+        return record->model->portConnectionPolicy(portType, portIndex) == ConnectionPolicy::Many;
     };
 
-    return getDataType(PortType::Out).id == getDataType(PortType::In).id
-           && portVacant(PortType::Out) && portVacant(PortType::In);
+    return portVacant(outRecord, PortType::Out) && portVacant(inRecord, PortType::In);
 }
 
 void DataFlowGraphModel::addConnection(ConnectionId const connectionId)
 {
-    _connectivity.insert(connectionId);
+    if (!connectionExists(connectionId)) {
+        // The data propagation would never terminate on a cycle.
+        if (!_topology.addEdge(connectionId.outNodeId, connectionId.inNodeId)) {
+            qWarning() << "Connection from node" << connectionId.outNodeId << "to node"
+                       << connectionId.inNodeId << "closes a cycle and was rejected";
+
+            Q_EMIT connectionRejected(connectionId);
+            return;
+        }
+
+        _reachability.invalidateEdge(connectionId.outNodeId, connectionId.inNodeId);
+
+        _connectivity.insert(connectionId);
+        indexConnection(connectionId);
+
+        ++_graphRevision;
+    }
 
     sendConnectionCreation(connectionId);
 
-    QVariant const portDataToPropagate = portData(connectionId.outNodeId,
-                                                  PortType::Out,
-                                                  connectionId.outPortIndex,
-                                                  PortRole::Data);
+    // The result of a running computation arrives through the new
+    // connection when the worker finishes.
+    if (_runningNodes.count(connectionId.outNodeId) > 0) {
+        // Every streamed result is delivered, none is cut off.
+        if (_propagationMode != PropagationMode::Streaming)
+            _lateConnections[connectionId.outNodeId].push_back(connectionId);
+
+        return;
+    }
+
+    NodeRecord const *outRecord = _nodes.find(connectionId.outNodeId);
+    if (!outRecord)
+        return;
 
-    setPortData(connectionId.inNodeId,
-                PortType::In,
-                connectionId.inPortIndex,
-                portDataToPropagate,
-                PortRole::Data);
+    deliverInData(connectionId.inNodeId,
+                  connectionId.inPortIndex,
+                  convertData(connectionId, outRecord->model->outData(connectionId.outPortIndex)));
 }
 
 void DataFlowGraphModel::sendConnectionCreation(ConnectionId const connectionId)
 {
-    Q_EMIT connectionCreated(connectionId);
+    notifyConnectionCreated(connectionId);
 
-    auto iti = _models.find(connectionId.inNodeId);
-    auto ito = _models.find(connectionId.outNodeId);
-    if (iti != _models.end() && ito != _models.end()) {
-        auto &modeli = iti->second;
-        auto &modelo = ito->second;
-        modeli->inputConnectionCreated(connectionId);
-        modelo->outputConnectionCreated(connectionId);
+    NodeRecord *recordi = _nodes.find(connectionId.inNodeId);
+    NodeRecord *recordo = _nodes.find(connectionId.outNodeId);
+    if (recordi && recordo) {
+        recordi->model->inputConnectionCreated(connectionId);
+        recordo->model->outputConnectionCreated(connectionId);
     }
 }
 
 void DataFlowGraphModel::sendConnectionDeletion(ConnectionId const connectionId)
 {
-    Q_EMIT connectionDeleted(connectionId);
+    notifyConnectionDeleted(connectionId);
+
+    NodeRecord *recordi = _nodes.find(connectionId.inNodeId);
+    NodeRecord *recordo = _nodes.find(connectionId.outNodeId);
+    if (recordi && recordo) {
+        recordi->model->inputConnectionDeleted(connectionId);
+        recordo->model->outputConnectionDeleted(connectionId);
+    }
+}
+
+void DataFlowGraphModel::indexConnection(ConnectionId const connectionId)
+{
+    for (PortType portType : {PortType::Out, PortType::In}) {
+        PortKey const key{getNodeId(portType, connectionId),
+                          portType,
+                          getPortIndex(portType, connectionId)};
+
+        _portConnections[key].insert(connectionId);
+    }
+}
+
+void DataFlowGraphModel::unindexConnection(ConnectionId const connectionId)
+{
+    for (PortType portType : {PortType::Out, PortType::In}) {
+        auto it = _portConnections.find(PortKey{getNodeId(portType, connectionId),
+                                                portType,
+                                                getPortIndex(portType, connectionId)});
+
+        if (it == _portConnections.end())
+            continue;
 
-    auto iti = _models.find(connectionId.inNodeId);
-    auto ito = _models.find(connectionId.outNodeId);
-    if (iti != _models.end() && ito != _models.end()) {
-        auto &modeli = iti->second;
-        auto &modelo = ito->second;
-        modeli->inputConnectionDeleted(connectionId);
-        modelo->outputConnectionDeleted(connectionId);
+        it->second.erase(connectionId);
+
+        if (it->second.empty())
+            _portConnections.erase(it);
     }
 }
 
 bool DataFlowGraphModel::nodeExists(NodeId const nodeId) const
 {
-    return (_models.find(nodeId) != _models.end());
+    return _nodes.contains(nodeId);
 }
 
 QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
 {
     QVariant result;
 
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
         return result;
 
-    auto &model = it->second;
+    auto &model = record->model;
 
     switch (role) {
     case NodeRole::Type:
@@ -195,11 +404,11 @@ QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
         break;
 
     case NodeRole::Position:
-        result = _nodeGeometryData[nodeId].pos;
+        result = record->geometry.pos;
         break;
 
     case NodeRole::Size:
-        result = _nodeGeometryData[nodeId].size;
+        result = record->geometry.size;
         break;
 
     case NodeRole::CaptionVisible:
@@ -210,15 +419,14 @@ QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
         result = model->caption();
         break;
 
-    case NodeRole::Style: {
-        auto style = StyleCollection::nodeStyle();
-        result = style.toJson().toVariantMap();
-    } break;
+    case NodeRole::Style:
+        result = model->nodeStyle().toJson().toVariantMap();
+        break;
 
     case NodeRole::InternalData: {
         QJsonObject nodeJson;
 
-        nodeJson["internal-data"] = _models.at(nodeId)->save();
+        nodeJson["internal-data"] = model->save();
 
         result = nodeJson.toVariantMap();
         break;
@@ -241,29 +449,119 @@ QVariant DataFlowGraphModel::nodeData(NodeId nodeId, NodeRole role) const
     return result;
 }
 
-NodeFlags DataFlowGraphModel::nodeFlags(NodeId nodeId) const
+QPointF DataFlowGraphModel::nodePosition(NodeId const nodeId) const
 {
-    auto it = _models.find(nodeId);
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->geometry.pos : QPointF();
+}
 
-    if (it != _models.end() && it->second->resizable())
-        return NodeFlag::Resizable;
+QSize DataFlowGraphModel::nodeSize(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
 
-    return NodeFlag::NoFlags;
+    return record ? record->geometry.size : QSize();
 }
 
-bool DataFlowGraphModel::setNodeData(NodeId nodeId, NodeRole role, QVariant value)
+bool DataFlowGraphModel::nodeCaptionVisible(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->captionVisible() : false;
+}
+
+QString DataFlowGraphModel::nodeCaption(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->caption() : QString();
+}
+
+QWidget *DataFlowGraphModel::nodeWidget(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->embeddedWidget() : nullptr;
+}
+
+NodeStyle DataFlowGraphModel::nodeStyle(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    // Same as `NodeRole::Style`, without the round trip through JSON.
+    return record ? record->model->nodeStyle() : StyleCollection::nodeStyle();
+}
+
+PortCount DataFlowGraphModel::portCount(NodeId const nodeId, PortType const portType) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->nPorts(portType) : 0u;
+}
+
+NodeDataType DataFlowGraphModel::portDataType(NodeId const nodeId,
+                                              PortType const portType,
+                                              PortIndex const portIndex) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
+        return NodeDataType();
+
+    auto const &types = (portType == PortType::In) ? record->inDataTypes : record->outDataTypes;
+
+    // Shares the strings of the cached type instead of asking the delegate.
+    return (portIndex < types.size()) ? types[portIndex]
+                                      : record->model->dataType(portType, portIndex);
+}
+
+bool DataFlowGraphModel::portCaptionVisible(NodeId const nodeId,
+                                            PortType const portType,
+                                            PortIndex const portIndex) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->portCaptionVisible(portType, portIndex) : false;
+}
+
+QString DataFlowGraphModel::portCaption(NodeId const nodeId,
+                                        PortType const portType,
+                                        PortIndex const portIndex) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->portCaption(portType, portIndex) : QString();
+}
+
+ConnectionPolicy DataFlowGraphModel::portConnectionPolicy(NodeId const nodeId,
+                                                         PortType const portType,
+                                                         PortIndex const portIndex) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->model->portConnectionPolicy(portType, portIndex)
+                  : ConnectionPolicy::One;
+}
+
+NodeFlags DataFlowGraphModel::nodeFlags(NodeId nodeId) const
 {
-    Q_UNUSED(nodeId);
-    Q_UNUSED(role);
-    Q_UNUSED(value);
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    return record ? record->flags : NodeFlags(NodeFlag::NoFlags);
+}
 
+bool DataFlowGraphModel::setNodeData(NodeId nodeId, NodeRole role, QVariant value)
+{
     bool result = false;
 
+    NodeRecord *record = _nodes.find(nodeId);
+    if (!record)
+        return result;
+
     switch (role) {
     case NodeRole::Type:
         break;
     case NodeRole::Position: {
-        _nodeGeometryData[nodeId].pos = value.value<QPointF>();
+        record->geometry.pos = value.value<QPointF>();
 
         Q_EMIT nodePositionUpdated(nodeId);
 
@@ -271,7 +569,7 @@ bool DataFlowGraphModel::setNodeData(NodeId nodeId, NodeRole role, QVariant valu
     } break;
 
     case NodeRole::Size: {
-        _nodeGeometryData[nodeId].size = value.value<QSize>();
+        record->geometry.size = value.value<QSize>();
         result = true;
     } break;
 
@@ -307,11 +605,11 @@ QVariant DataFlowGraphModel::portData(NodeId nodeId,
 {
     QVariant result;
 
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
         return result;
 
-    auto &model = it->second;
+    auto &model = record->model;
 
     switch (role) {
     case PortRole::Data:
@@ -343,24 +641,13 @@ QVariant DataFlowGraphModel::portData(NodeId nodeId,
 bool DataFlowGraphModel::setPortData(
     NodeId nodeId, PortType portType, PortIndex portIndex, QVariant const &value, PortRole role)
 {
-    Q_UNUSED(nodeId);
-
-    QVariant result;
-
-    auto it = _models.find(nodeId);
-    if (it == _models.end())
+    if (!_nodes.contains(nodeId))
         return false;
 
-    auto &model = it->second;
-
     switch (role) {
     case PortRole::Data:
-        if (portType == PortType::In) {
-            model->setInData(value.value<std::shared_ptr<NodeData>>(), portIndex);
-
-            // Triggers repainting on the scene.
-            Q_EMIT inPortDataWasSet(nodeId, portType, portIndex);
-        }
+        if (portType == PortType::In)
+            deliverInData(nodeId, portIndex, value.value<std::shared_ptr<NodeData>>());
         break;
 
     default:
@@ -380,6 +667,17 @@ bool DataFlowGraphModel::deleteConnection(ConnectionId const connectionId)
         disconnected = true;
 
         _connectivity.erase(it);
+
+        unindexConnection(connectionId);
+
+        _topology.removeEdge(connectionId.outNodeId, connectionId.inNodeId);
+
+        _reachability.invalidateEdge(connectionId.outNodeId, connectionId.inNodeId);
+
+        ++_graphRevision;
+
+        if (_streamQueues.erase(connectionId) > 0)
+            updateThrottling(connectionId.outNodeId);
     }
 
     if (disconnected) {
@@ -400,10 +698,40 @@ bool DataFlowGraphModel::deleteNode(NodeId const nodeId)
         deleteConnection(cId);
     }
 
-    _nodeGeometryData.erase(nodeId);
-    _models.erase(nodeId);
+    auto running = _runningNodes.find(nodeId);
+    if (running != _runningNodes.end()) {
+        running->second.cancel();
+        _runningNodes.erase(running);
+
+        // The worker still uses the delegate, it is released on completion.
+        NodeRecord *record = _nodes.find(nodeId);
+        if (record)
+            _retiredModels.push_back(std::move(record->model));
+    }
+
+    _stagedInData.erase(nodeId);
+    _lateConnections.erase(nodeId);
+    _deferredNodes.erase(nodeId);
+    _pendingNodes.erase(nodeId);
+    _observedNodes.erase(nodeId);
+    _sinkNodes.erase(nodeId);
+    _pullTargets.erase(nodeId);
+    _demandedNodesValid = false;
+    _throttledNodes.erase(nodeId);
+    _invalidPorts.erase(nodeId);
+    _deferredInvalidations.erase(nodeId);
 
-    Q_EMIT nodeDeleted(nodeId);
+    _outputCache.invalidateNode(nodeId);
+
+    _nodes.erase(nodeId);
+
+    _topology.removeNode(nodeId);
+
+    _reachability.invalidateNode(nodeId);
+
+    ++_graphRevision;
+
+    notifyNodeDeleted(nodeId);
 
     return true;
 }
@@ -414,7 +742,10 @@ QJsonObject DataFlowGraphModel::saveNode(NodeId const nodeId) const
 
     nodeJson["id"] = static_cast<qint64>(nodeId);
 
-    nodeJson["internal-data"] = _models.at(nodeId)->save();
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    if (record)
+        nodeJson["internal-data"] = record->model->save();
 
     {
         QPointF const pos = nodeData(nodeId, NodeRole::Position).value<QPointF>();
@@ -456,7 +787,15 @@ void DataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
     // loading.
     // 2. When undoing the deletion command.  Conflict is not possible
     // because all the new ids were created past the removed nodes.
-    NodeId restoredNodeId = nodeJson["id"].toInt();
+    double const id = nodeJson["id"].toDouble(-1.0);
+
+    // The ids index the node storage and every new node takes the next
+    // one, so garbage from a hand-edited file is rejected here.
+    if (id < 0.0 || id >= static_cast<double>(InvalidNodeId - 1) || id != std::floor(id))
+        throw std::logic_error(std::string("Invalid node id ")
+                               + QString::number(id).toLocal8Bit().data());
+
+    NodeId restoredNodeId = static_cast<NodeId>(id);
 
     _nextNodeId = std::max(_nextNodeId, restoredNodeId + 1);
 
@@ -467,46 +806,21 @@ void DataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
     std::unique_ptr<NodeDelegateModel> model = _registry->create(delegateModelName);
 
     if (model) {
-        connect(model.get(),
-                &NodeDelegateModel::dataUpdated,
-                [restoredNodeId, this](PortIndex const portIndex) {
-                    onOutPortDataUpdated(restoredNodeId, portIndex);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeDeleted,
-                this,
-                [restoredNodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeDeleted(restoredNodeId, portType, first, last);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsDeleted,
-                this,
-                &DataFlowGraphModel::portsDeleted);
+        NodeDelegateModel *restoredModel = model.get();
 
-        connect(model.get(),
-                &NodeDelegateModel::portsAboutToBeInserted,
-                this,
-                [restoredNodeId, this](PortType const portType, PortIndex const first, PortIndex const last) {
-                    portsAboutToBeInserted(restoredNodeId, portType, first, last);
-                });
-
-        connect(model.get(),
-                &NodeDelegateModel::portsInserted,
-                this,
-                &DataFlowGraphModel::portsInserted);
+        attachDelegate(restoredNodeId, std::move(model));
 
-        _models[restoredNodeId] = std::move(model);
-
-        Q_EMIT nodeCreated(restoredNodeId);
+        notifyNodeCreated(restoredNodeId);
 
         QJsonObject posJson = nodeJson["position"].toObject();
         QPointF const pos(posJson["x"].toDouble(), posJson["y"].toDouble());
 
         setNodeData(restoredNodeId, NodeRole::Position, pos);
 
-        _models[restoredNodeId]->load(internalDataJson);
+        restoredModel->load(internalDataJson);
+
+        // Also drops the outputs cached for a node deleted under this id.
+        updatePortDataTypes(restoredNodeId);
     } else {
         throw std::logic_error(std::string("No registered model with name ")
                                + delegateModelName.toLocal8Bit().data());
@@ -515,6 +829,8 @@ void DataFlowGraphModel::loadNode(QJsonObject const &nodeJson)
 
 void DataFlowGraphModel::load(QJsonObject const &jsonDocument)
 {
+    GraphModelBatch batch(*this);
+
     QJsonArray nodesJsonArray = jsonDocument["nodes"].toArray();
 
     for (QJsonValueRef nodeJson : nodesJsonArray) {
@@ -528,29 +844,1661 @@ void DataFlowGraphModel::load(QJsonObject const &jsonDocument)
 
         ConnectionId connId = fromJson(connJson);
 
+        if (!connectionExists(connId)
+            && _topology.wouldCreateCycle(connId.outNodeId, connId.inNodeId)) {
+            throw std::logic_error("Connection from node " + std::to_string(connId.outNodeId)
+                                   + " to node " + std::to_string(connId.inNodeId)
+                                   + " closes a cycle");
+        }
+
         // Restore the connection
         addConnection(connId);
     }
 }
 
+void DataFlowGraphModel::updatePortDataTypes(NodeId const nodeId)
+{
+    NodeRecord *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    auto update = [&](PortType const portType,
+                      std::vector<DataTypeId> &types,
+                      std::vector<NodeDataType> &dataTypes) {
+        unsigned int const nPorts = record->model->nPorts(portType);
+
+        types.resize(nPorts);
+        dataTypes.resize(nPorts);
+
+        for (PortIndex portIndex = 0; portIndex < nPorts; ++portIndex) {
+            dataTypes[portIndex] = record->model->dataType(portType, portIndex);
+            types[portIndex] = _registry->dataTypeId(dataTypes[portIndex]);
+        }
+    };
+
+    update(PortType::In, record->inTypes, record->inDataTypes);
+    update(PortType::Out, record->outTypes, record->outDataTypes);
+
+    record->inData.resize(record->inTypes.size());
+    record->outData.resize(record->outTypes.size());
+    record->outRevisions.resize(record->outTypes.size());
+
+    ++_graphRevision;
+
+    _outputCache.invalidateNode(nodeId);
+
+    if (record->outTypes.empty()) {
+        _sinkNodes.insert(nodeId);
+    } else {
+        _sinkNodes.erase(nodeId);
+    }
+
+    _demandedNodesValid = false;
+}
+
 void DataFlowGraphModel::onOutPortDataUpdated(NodeId const nodeId, PortIndex const portIndex)
 {
-    std::unordered_set<ConnectionId> const &connected = connections(nodeId,
-                                                                    PortType::Out,
-                                                                    portIndex);
+    if (outputCapture && outputCapture->nodeId == nodeId) {
+        // The data is staged by the code that started the computation,
+        // possibly on a worker thread.
+        std::shared_ptr<NodeData> nodeData = outputCapture->model->outData(portIndex);
+
+        for (auto &output : outputCapture->outputs) {
+            if (output.first == portIndex) {
+                output.second = std::move(nodeData);
+                return;
+            }
+        }
+
+        outputCapture->outputs.emplace_back(portIndex, std::move(nodeData));
+        return;
+    }
+
+    NodeRecord *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    // The node changed its outputs on its own, e.g. after editing a
+    // parameter, so the results remembered for its inputs are stale. The
+    // cascade does not use them, but the mode may change later on.
+    if (record->model->memoizable())
+        _outputCache.invalidateNode(nodeId);
+
+    if (_propagationMode != PropagationMode::Cascade) {
+        // Every update of a source is queued, none is coalesced.
+        if (_propagationMode == PropagationMode::Streaming) {
+            stageOutputs(nodeId, {{portIndex, record->model->outData(portIndex)}});
+            runPropagationWave();
+            return;
+        }
+
+        // Updates arriving outside of a wave come from the sources and may
+        // be coalesced, only the latest value gets delivered.
+        if (_coalescingInterval >= 0 && !_propagating) {
+            std::pair<NodeId, PortIndex> const output{nodeId, portIndex};
+
+            if (std::find(_coalescedOutputs.begin(), _coalescedOutputs.end(), output)
+                == _coalescedOutputs.end())
+                _coalescedOutputs.push_back(output);
+
+            if (!_coalescingTimer.isActive())
+                _coalescingTimer.start(_coalescingInterval);
+
+            return;
+        }
+
+        std::shared_ptr<NodeData> nodeData = record->model->outData(portIndex);
+
+        // Nothing downstream changes when the payload did not.
+        if (!outputChanged(*record, portIndex, nodeData))
+            return;
+
+        std::size_t remaining = connectionCount(nodeId, PortType::Out, portIndex);
 
-    QVariant const portDataToPropagate = portData(nodeId, PortType::Out, portIndex, PortRole::Data);
+        forEachConnection(nodeId, PortType::Out, portIndex, [&](ConnectionId const &cn) {
+            // Only the fan-out copies the reference, the last port takes it over.
+            if (--remaining > 0) {
+                stageInData(cn.inNodeId, cn.inPortIndex, convertData(cn, nodeData));
+            } else {
+                stageInData(cn.inNodeId, cn.inPortIndex, convertData(cn, std::move(nodeData)));
+            }
+        });
+
+        runPropagationWave();
+        return;
+    }
+
+    std::shared_ptr<NodeData> nodeData = record->model->outData(portIndex);
+
+    // A copy, the delegates downstream may change the connections.
+    std::unordered_set<ConnectionId> const connected = connections(nodeId,
+                                                                   PortType::Out,
+                                                                   portIndex);
+
+    std::size_t remaining = connected.size();
 
     for (auto const &cn : connected) {
-        setPortData(cn.inNodeId, PortType::In, cn.inPortIndex, portDataToPropagate, PortRole::Data);
+        if (--remaining > 0) {
+            deliverInData(cn.inNodeId, cn.inPortIndex, convertData(cn, nodeData));
+        } else {
+            deliverInData(cn.inNodeId, cn.inPortIndex, convertData(cn, std::move(nodeData)));
+        }
     }
 }
 
-void DataFlowGraphModel::propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex)
+void DataFlowGraphModel::deliverInData(NodeId const nodeId,
+                                       PortIndex const portIndex,
+                                       std::shared_ptr<NodeData> nodeData)
+{
+    if (_propagationMode != PropagationMode::Cascade) {
+        stageInData(nodeId, portIndex, std::move(nodeData));
+        runPropagationWave();
+        return;
+    }
+
+    NodeRecord *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    record->model->setInData(std::move(nodeData), portIndex);
+
+    // Triggers repainting on the scene.
+    Q_EMIT inPortDataWasSet(nodeId, PortType::In, portIndex);
+}
+
+TypeConverter const *DataFlowGraphModel::connectionConverter(
+    ConnectionId const &connectionId) const
+{
+    NodeRecord const *outRecord = _nodes.find(connectionId.outNodeId);
+    NodeRecord const *inRecord = _nodes.find(connectionId.inNodeId);
+
+    if (!outRecord || !inRecord || connectionId.outPortIndex >= outRecord->outTypes.size()
+        || connectionId.inPortIndex >= inRecord->inTypes.size())
+        return nullptr;
+
+    return _registry->typeConverter(outRecord->outTypes[connectionId.outPortIndex],
+                                    inRecord->inTypes[connectionId.inPortIndex]);
+}
+
+std::shared_ptr<NodeData> DataFlowGraphModel::convertData(ConnectionId const &connectionId,
+                                                          std::shared_ptr<NodeData> nodeData) const
+{
+    // Empty data stays empty whatever the port types are.
+    if (!nodeData)
+        return nodeData;
+
+    TypeConverter const *converter = connectionConverter(connectionId);
+
+    return converter ? (*converter)(std::move(nodeData)) : nodeData;
+}
+
+void DataFlowGraphModel::onOutPortDataInvalidated(NodeId const nodeId, PortIndex const portIndex)
 {
-    QVariant emptyData{};
+    // Invalidations emitted while computing on a worker travel downstream
+    // as empty data, the graph must not be touched from there.
+    if (outputCapture || _propagationMode == PropagationMode::Cascade
+        || _propagationMode == PropagationMode::Streaming)
+        return;
+
+    // A coalesced update from before the invalidation is outdated.
+    _coalescedOutputs.erase(std::remove(_coalescedOutputs.begin(),
+                                        _coalescedOutputs.end(),
+                                        std::make_pair(nodeId, portIndex)),
+                            _coalescedOutputs.end());
+
+    // Whatever the port sends next is new to the cutoff.
+    if (NodeRecord *origin = _nodes.find(nodeId)) {
+        if (portIndex < origin->outData.size())
+            origin->outData[portIndex].reset();
+    }
+
+    std::vector<ConnectionId> frontier;
+
+    forEachConnection(nodeId, PortType::Out, portIndex, [&](ConnectionId const &cn) {
+        frontier.push_back(cn);
+    });
+
+    while (!frontier.empty()) {
+        ConnectionId const cn = frontier.back();
+        frontier.pop_back();
+
+        NodeRecord *record = _nodes.find(cn.inNodeId);
+        if (!record)
+            continue;
+
+        std::vector<PortIndex> &ports = _invalidPorts[cn.inNodeId];
+
+        if (std::find(ports.begin(), ports.end(), cn.inPortIndex) != ports.end())
+            continue;
+
+        bool const firstPort = ports.empty();
 
-    setPortData(nodeId, PortType::In, portIndex, emptyData, PortRole::Data);
+        ports.push_back(cn.inPortIndex);
+
+        if (cn.inPortIndex < record->inData.size())
+            record->inData[cn.inPortIndex].reset();
+
+        // Data staged before the invalidation is outdated as well.
+        auto staged = _stagedInData.find(cn.inNodeId);
+        if (staged != _stagedInData.end()) {
+            auto &inputs = staged->second;
+
+            inputs.erase(std::remove_if(inputs.begin(),
+                                        inputs.end(),
+                                        [&cn](auto const &input) {
+                                            return input.first == cn.inPortIndex;
+                                        }),
+                         inputs.end());
+
+            if (inputs.empty())
+                _stagedInData.erase(staged);
+        }
+
+        Q_EMIT inPortDataWasSet(cn.inNodeId, PortType::In, cn.inPortIndex);
+
+        // The outputs of the node were invalidated with its first port.
+        if (!firstPort)
+            continue;
+
+        for (auto &outData : record->outData) {
+            outData.reset();
+        }
+
+        // The worker owns the delegate until it finishes, the result it
+        // is computing is outdated.
+        auto running = _runningNodes.find(cn.inNodeId);
+        if (running != _runningNodes.end()) {
+            running->second.cancel();
+            _deferredInvalidations.insert(cn.inNodeId);
+        } else {
+            QSignalBlocker const blocker(record->model.get());
+
+            record->model->inputsInvalidated();
+        }
+
+        for (PortIndex outPort = 0; outPort < record->outTypes.size(); ++outPort) {
+            forEachConnection(cn.inNodeId, PortType::Out, outPort, [&](ConnectionId const &next) {
+                frontier.push_back(next);
+            });
+        }
+    }
+}
+
+void DataFlowGraphModel::propagateEmptyDataTo(NodeId const nodeId, PortIndex const portIndex)
+{
+    deliverInData(nodeId, portIndex, nullptr);
+}
+
+void DataFlowGraphModel::setPropagationMode(PropagationMode const mode)
+{
+    if (mode == _propagationMode)
+        return;
+
+    _propagationMode = mode;
+
+    // Only the newest queued update of every connection survives leaving
+    // the streaming mode.
+    for (auto &queue : _streamQueues) {
+        if (!queue.second.empty())
+            stageInData(queue.first.inNodeId, queue.first.inPortIndex, queue.second.back());
+    }
+
+    _streamQueues.clear();
+
+    std::unordered_set<NodeId> throttled;
+    throttled.swap(_throttledNodes);
+
+    for (NodeId const nodeId : throttled) {
+        if (NodeRecord *record = _nodes.find(nodeId))
+            Q_EMIT record->model->backpressureChanged(false);
+    }
+
+    // Nothing stays pending outside of the lazy mode.
+    if (mode != PropagationMode::Lazy) {
+        for (NodeId const nodeId : _pendingNodes) {
+            _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+        }
+
+        _pendingNodes.clear();
+    }
+
+    runPropagationWave();
+}
+
+void DataFlowGraphModel::setNodeObserved(NodeId const nodeId, bool const observed)
+{
+    if (!observed) {
+        _observedNodes.erase(nodeId);
+        _demandedNodesValid = false;
+        return;
+    }
+
+    if (!nodeExists(nodeId) || !_observedNodes.insert(nodeId).second)
+        return;
+
+    _demandedNodesValid = false;
+
+    if (schedulePendingUpstreamOf(nodeId))
+        runPropagationWave();
+}
+
+bool DataFlowGraphModel::nodeObserved(NodeId const nodeId) const
+{
+    return _observedNodes.count(nodeId) > 0 || _sinkNodes.count(nodeId) > 0;
+}
+
+void DataFlowGraphModel::evaluate(NodeId const nodeId)
+{
+    if (!nodeExists(nodeId))
+        return;
+
+    if (_pullTargets.insert(nodeId).second)
+        _demandedNodesValid = false;
+
+    schedulePendingUpstreamOf(nodeId);
+
+    runPropagationWave();
+}
+
+bool DataFlowGraphModel::isDemanded(NodeId const nodeId) const
+{
+    if (_propagationMode != PropagationMode::Lazy)
+        return true;
+
+    return _reachability.contains(demandedNodes(), nodeId);
+}
+
+NodeBitSet const &DataFlowGraphModel::demandedNodes() const
+{
+    if (_demandedNodesValid && _demandedNodesRevision == _graphRevision)
+        return _demandedNodes;
+
+    // One upstream walk per demanding node, the queries of a wave then
+    // only test the membership.
+    _demandedNodes.clear();
+
+    for (auto const *demanding : {&_observedNodes, &_sinkNodes, &_pullTargets}) {
+        for (NodeId const target : *demanding) {
+            _reachability.collect(target, ReachabilityCache::Direction::Upstream, _demandedNodes);
+        }
+    }
+
+    _demandedNodesValid = true;
+    _demandedNodesRevision = _graphRevision;
+
+    return _demandedNodes;
+}
+
+bool DataFlowGraphModel::schedulePendingUpstreamOf(NodeId const nodeId)
+{
+    if (_pendingNodes.empty())
+        return false;
+
+    NodeBitSet upstream;
+    _reachability.collect(nodeId, ReachabilityCache::Direction::Upstream, upstream);
+
+    bool scheduled = false;
+
+    for (auto it = _pendingNodes.begin(); it != _pendingNodes.end();) {
+        if (_reachability.contains(upstream, *it)) {
+            _dirtyNodes.emplace(_topology.rank(*it), *it);
+            it = _pendingNodes.erase(it);
+            scheduled = true;
+        } else {
+            ++it;
+        }
+    }
+
+    return scheduled;
+}
+
+void DataFlowGraphModel::stageInData(NodeId const nodeId,
+                                     PortIndex const portIndex,
+                                     std::shared_ptr<NodeData> nodeData)
+{
+    // Empty data adds nothing to an invalidated port, the node stays
+    // untouched until valid data arrives.
+    if (!nodeData) {
+        auto invalid = _invalidPorts.find(nodeId);
+
+        if (invalid != _invalidPorts.end()
+            && std::find(invalid->second.begin(), invalid->second.end(), portIndex)
+                   != invalid->second.end())
+            return;
+    }
+
+    // A running computation of the node works with outdated inputs now.
+    // A streaming node processes every update, it fires again afterwards.
+    auto running = _runningNodes.find(nodeId);
+    if (running != _runningNodes.end() && _propagationMode != PropagationMode::Streaming)
+        running->second.cancel();
+
+    auto it = _stagedInData.find(nodeId);
+
+    if (it == _stagedInData.end()) {
+        _stagedInData[nodeId].emplace_back(portIndex, std::move(nodeData));
+        _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+        return;
+    }
+
+    for (auto &input : it->second) {
+        if (input.first == portIndex) {
+            input.second = std::move(nodeData);
+            return;
+        }
+    }
+
+    it->second.emplace_back(portIndex, std::move(nodeData));
+}
+
+void DataFlowGraphModel::runPropagationWave()
+{
+    if (_propagationMode == PropagationMode::Streaming) {
+        runStreamingWave();
+        return;
+    }
+
+    if (_propagating)
+        return;
+
+    _propagating = true;
+
+    while (!_dirtyNodes.empty()) {
+        NodeId const nodeId = _dirtyNodes.top().second;
+        _dirtyNodes.pop();
+
+        auto it = _stagedInData.find(nodeId);
+        if (it == _stagedInData.end())
+            continue;
+
+        if (!isDemanded(nodeId)) {
+            _pendingNodes.insert(nodeId);
+            continue;
+        }
+
+        // Inputs left pending upstream by the lazy mode are brought up to
+        // date first, the node comes back after them.
+        if (_propagationMode == PropagationMode::Lazy && schedulePendingUpstreamOf(nodeId)) {
+            _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+            continue;
+        }
+
+        // The staged inputs stay in place until the node gets its turn.
+        if (_runningNodes.count(nodeId) > 0 || waitsForUpstream(nodeId)) {
+            _deferredNodes.insert(nodeId);
+            continue;
+        }
+
+        NodeDelegateModel::PortDataList inputs = std::move(it->second);
+        _stagedInData.erase(it);
+
+        // The invalidated ports not fed again are empty from now on.
+        auto invalid = _invalidPorts.find(nodeId);
+        if (invalid != _invalidPorts.end()) {
+            for (PortIndex const portIndex : invalid->second) {
+                bool const fed = std::any_of(inputs.begin(),
+                                             inputs.end(),
+                                             [portIndex](auto const &i) {
+                                                 return i.first == portIndex;
+                                             });
+
+                if (!fed)
+                    inputs.emplace_back(portIndex, nullptr);
+            }
+
+            _invalidPorts.erase(invalid);
+        }
+
+        // The node could have been deleted by an earlier computation.
+        NodeRecord *record = _nodes.find(nodeId);
+        if (!record)
+            continue;
+
+        NodeDelegateModel *model = record->model.get();
+
+        for (auto const &input : inputs) {
+            if (input.first < record->inData.size())
+                record->inData[input.first] = input.second;
+        }
+
+        completeInputs(*record, inputs);
+
+        Computation computation{nodeId, model, CancellationToken(), false, 0, {}, {}, {}};
+        computation.inputs = std::move(inputs);
+
+        if (_outputCache.budget() > 0 && model->memoizable() && model->acceptsComputeResult()) {
+            computation.memoKey = inputFingerprint(*record);
+
+            NodeDelegateModel::PortDataList const *cached
+                = computation.memoKey ? _outputCache.find(nodeId, computation.memoKey) : nullptr;
+
+            if (cached) {
+                NodeDelegateModel::PortDataList const outputs = *cached;
+
+                captureOutputs(nodeId, model, [&]() { model->setComputeResult(outputs); });
+
+                // Without its own `setComputeResult` the node would keep its
+                // old outputs, it computes the cached ones again instead.
+                if (model->acceptsComputeResult()) {
+                    // Only the outputs were restored.
+                    record->staleInputs = true;
+
+                    for (auto const &input : computation.inputs) {
+                        Q_EMIT inPortDataWasSet(nodeId, PortType::In, input.first);
+                    }
+
+                    stageOutputs(nodeId, outputs);
+                    continue;
+                }
+
+                computation.memoKey = 0;
+            }
+        }
+
+        NodeDelegateModel::ComputeTask task = model->computeTask(computation.inputs);
+
+        if (runsOnWorker(model, task)) {
+            computation.asyncTask = static_cast<bool>(task);
+            computation.chain = chainDownstreamOf(nodeId);
+            dispatchToWorker(std::move(computation), std::move(task));
+            continue;
+        }
+
+        if (computation.memoKey != 0) {
+            NodeDelegateModel::PortDataList outputs
+                = captureOutputs(nodeId, model, [&]() {
+                      model->setChangedInData(computation.inputs);
+                  });
+
+            for (auto const &input : computation.inputs) {
+                Q_EMIT inPortDataWasSet(nodeId, PortType::In, input.first);
+            }
+
+            stageOutputs(nodeId, outputs);
+
+            _outputCache.insert(nodeId, computation.memoKey, std::move(outputs));
+            continue;
+        }
+
+        // Outputs emitted here are staged for the nodes ranked further.
+        model->setChangedInData(computation.inputs);
+
+        for (auto const &input : computation.inputs) {
+            // Triggers repainting on the scene.
+            Q_EMIT inPortDataWasSet(nodeId, PortType::In, input.first);
+        }
+    }
+
+    _propagating = false;
+
+    // Requested nodes stay demanded until nothing upstream can change them.
+    for (auto it = _pullTargets.begin(); it != _pullTargets.end();) {
+        bool const settled = _stagedInData.count(*it) == 0 && _runningNodes.count(*it) == 0
+                             && !waitsForUpstream(*it);
+
+        if (settled) {
+            it = _pullTargets.erase(it);
+            _demandedNodesValid = false;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DataFlowGraphModel::setWorkerThreadCount(unsigned int const count)
+{
+    if (count == _workerThreadCount)
+        return;
+
+    _workerThreadCount = count;
+
+    // Destroying the old pool waits for the queued computations, their
+    // results are still delivered through the event loop.
+    _threadPool.reset();
+}
+
+WorkStealingThreadPool &DataFlowGraphModel::threadPool()
+{
+    if (!_threadPool)
+        _threadPool = std::make_unique<WorkStealingThreadPool>(_workerThreadCount);
+
+    return *_threadPool;
+}
+
+WorkStealingThreadPool &DataFlowGraphModel::ioThread()
+{
+    if (!_ioThread)
+        _ioThread = std::make_unique<WorkStealingThreadPool>(1);
+
+    return *_ioThread;
+}
+
+bool DataFlowGraphModel::runsOnWorker(NodeDelegateModel const *model,
+                                      NodeDelegateModel::ComputeTask const &task) const
+{
+    switch (model->affinity()) {
+    case NodeDelegateModel::ExecutionAffinity::IoThread:
+        return true;
+
+    case NodeDelegateModel::ExecutionAffinity::AnyThread:
+        return task || _workerThreadCount > 0;
+
+    default:
+        return static_cast<bool>(task);
+    }
+}
+
+bool DataFlowGraphModel::waitsForUpstream(NodeId const nodeId) const
+{
+    for (auto const &running : _runningNodes) {
+        if (reaches(running.first, nodeId))
+            return true;
+    }
+
+    for (NodeId const deferred : _deferredNodes) {
+        if (deferred != nodeId && reaches(deferred, nodeId))
+            return true;
+    }
+
+    return false;
+}
+
+void DataFlowGraphModel::dispatchToWorker(Computation computation,
+                                          NodeDelegateModel::ComputeTask task)
+{
+    _runningNodes[computation.nodeId] = computation.token;
+
+    Q_EMIT computation.model->computingStarted();
+
+    for (ChainLink const &link : computation.chain) {
+        _runningNodes[link.nodeId] = link.token;
+
+        Q_EMIT link.model->computingStarted();
+    }
+
+    WorkStealingThreadPool &pool = (computation.model->affinity()
+                                    == NodeDelegateModel::ExecutionAffinity::IoThread)
+                                       ? ioThread()
+                                       : threadPool();
+
+    pool.submit([this, computation, task]() mutable {
+        if (task) {
+            computation.outputs = task(computation.token);
+        } else {
+            NodeDelegateModel *model = computation.model;
+
+            computation.outputs = captureOutputs(computation.nodeId, model, [&]() {
+                model->setChangedInData(computation.inputs);
+            });
+        }
+
+        // The outputs stay on this thread as long as the nodes downstream
+        // may run here too.
+        NodeDelegateModel::PortDataList const *previous = &computation.outputs;
+        CancellationToken const *previousToken = &computation.token;
+
+        for (ChainLink &link : computation.chain) {
+            if (previousToken->isCancelled() || link.token.isCancelled())
+                break;
+
+            for (auto const &port : link.ports) {
+                for (auto const &output : *previous) {
+                    if (output.first == port.first)
+                        link.inputs.emplace_back(port.second, output.second);
+                }
+            }
+
+            if (link.inputs.empty())
+                break;
+
+            NodeDelegateModel *model = link.model;
+
+            NodeDelegateModel::ComputeTask linkTask = model->computeTask(link.inputs);
+
+            link.asyncTask = static_cast<bool>(linkTask);
+
+            if (linkTask) {
+                link.outputs = linkTask(link.token);
+            } else {
+                link.outputs = captureOutputs(link.nodeId, model, [&]() {
+                    model->setChangedInData(link.inputs);
+                });
+            }
+
+            link.evaluated = true;
+
+            previous = &link.outputs;
+            previousToken = &link.token;
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, computation]() { onWorkerFinished(computation); },
+            Qt::QueuedConnection);
+    });
+}
+
+void DataFlowGraphModel::onWorkerFinished(Computation const &computation)
+{
+    NodeId const nodeId = computation.nodeId;
+    NodeDelegateModel *model = computation.model;
+
+    std::size_t const chainLength = computation.chain.size();
+
+    // A link is accepted when its own results and those of all the nodes
+    // before it are valid; the outputs feeding an accepted link are
+    // already consumed and must not be staged again.
+    std::vector<bool> accepted(chainLength + 1);
+
+    accepted[0] = !computation.token.isCancelled();
+
+    for (std::size_t i = 0; i < chainLength; ++i) {
+        ChainLink const &link = computation.chain[i];
+
+        accepted[i + 1] = accepted[i] && link.evaluated && !link.token.isCancelled();
+    }
+
+    auto skippedAfter = [&](std::size_t const i) {
+        return (i < chainLength && accepted[i + 1]) ? computation.chain[i].nodeId : InvalidNodeId;
+    };
+
+    if (!releaseRetiredModel(model)) {
+        _runningNodes.erase(nodeId);
+
+        Q_EMIT model->computingFinished();
+
+        finishInvalidation(nodeId, model);
+
+        for (auto const &input : computation.inputs) {
+            Q_EMIT inPortDataWasSet(nodeId, PortType::In, input.first);
+        }
+
+        // Superseded results are dropped, the node is already deferred
+        // with the newer inputs.
+        if (accepted[0]) {
+            if (computation.asyncTask) {
+                captureOutputs(nodeId, model, [&]() { model->setComputeResult(computation.outputs); });
+            }
+
+            stageOutputs(nodeId, computation.outputs, skippedAfter(0));
+
+            if (computation.memoKey != 0)
+                _outputCache.insert(nodeId, computation.memoKey, computation.outputs);
+        }
+
+        stageLateConnections(nodeId);
+
+        // More updates could have been queued for the node meanwhile.
+        if (_propagationMode == PropagationMode::Streaming)
+            _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+    }
+
+    for (std::size_t i = 0; i < chainLength; ++i) {
+        ChainLink const &link = computation.chain[i];
+
+        if (releaseRetiredModel(link.model))
+            continue;
+
+        _runningNodes.erase(link.nodeId);
+
+        Q_EMIT link.model->computingFinished();
+
+        finishInvalidation(link.nodeId, link.model);
+
+        if (!accepted[i + 1]) {
+            stageLateConnections(link.nodeId);
+            continue;
+        }
+
+        if (NodeRecord *record = _nodes.find(link.nodeId)) {
+            for (auto const &input : link.inputs) {
+                if (input.first < record->inData.size())
+                    record->inData[input.first] = input.second;
+            }
+        }
+
+        for (auto const &input : link.inputs) {
+            Q_EMIT inPortDataWasSet(link.nodeId, PortType::In, input.first);
+        }
+
+        if (link.asyncTask) {
+            NodeDelegateModel *linkModel = link.model;
+
+            captureOutputs(link.nodeId, linkModel, [&]() {
+                linkModel->setComputeResult(link.outputs);
+            });
+        }
+
+        stageOutputs(link.nodeId, link.outputs, skippedAfter(i + 1));
+
+        stageLateConnections(link.nodeId);
+    }
+
+    for (NodeId const deferred : _deferredNodes) {
+        _dirtyNodes.emplace(_topology.rank(deferred), deferred);
+    }
+
+    _deferredNodes.clear();
+
+    runPropagationWave();
+}
+
+void DataFlowGraphModel::finishInvalidation(NodeId const nodeId, NodeDelegateModel *model)
+{
+    if (_deferredInvalidations.erase(nodeId) == 0)
+        return;
+
+    QSignalBlocker const blocker(model);
+
+    model->inputsInvalidated();
+}
+
+void DataFlowGraphModel::stageLateConnections(NodeId const nodeId)
+{
+    auto late = _lateConnections.find(nodeId);
+    if (late == _lateConnections.end())
+        return;
+
+    std::vector<ConnectionId> const connections = std::move(late->second);
+    _lateConnections.erase(late);
+
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    // The outputs remembered by the cutoff are the latest ones sent to
+    // the other connections, either the new result or, when the result
+    // was dropped, those from before the computation.
+    for (ConnectionId const &cn : connections) {
+        if (!connectionExists(cn) || cn.outPortIndex >= record->outData.size())
+            continue;
+
+        stageInData(cn.inNodeId, cn.inPortIndex, convertData(cn, record->outData[cn.outPortIndex]));
+    }
+}
+
+bool DataFlowGraphModel::releaseRetiredModel(NodeDelegateModel *model)
+{
+    auto retired = std::find_if(_retiredModels.begin(),
+                                _retiredModels.end(),
+                                [model](std::unique_ptr<NodeDelegateModel> const &m) {
+                                    return m.get() == model;
+                                });
+
+    if (retired == _retiredModels.end())
+        return false;
+
+    _retiredModels.erase(retired);
+
+    return true;
+}
+
+std::vector<DataFlowGraphModel::ChainLink> DataFlowGraphModel::chainDownstreamOf(
+    NodeId const nodeId) const
+{
+    std::vector<ChainLink> chain;
+
+    if (_workerThreadCount == 0)
+        return chain;
+
+    NodeId current = nodeId;
+
+    for (;;) {
+        NodeId next = InvalidNodeId;
+
+        _topology.forEachSuccessor(current, [&](NodeId const successor) {
+            if (next != InvalidNodeId)
+                return;
+
+            NodeRecord const *record = _nodes.find(successor);
+
+            bool const eligible
+                = record
+                  && record->model->affinity() == NodeDelegateModel::ExecutionAffinity::AnyThread
+                  && !(record->model->memoizable() && _outputCache.budget() > 0)
+                  && _runningNodes.count(successor) == 0 && _stagedInData.count(successor) == 0
+                  && _deferredNodes.count(successor) == 0 && _invalidPorts.count(successor) == 0
+                  && !record->staleInputs && isDemanded(successor);
+
+            if (!eligible)
+                return;
+
+            // Data from other nodes could still be on its way.
+            bool fedByOthers = false;
+
+            _topology.forEachPredecessor(successor, [&](NodeId const predecessor) {
+                if (predecessor != current)
+                    fedByOthers = true;
+            });
+
+            if (!fedByOthers)
+                next = successor;
+        });
+
+        if (next == InvalidNodeId)
+            break;
+
+        NodeRecord const *record = _nodes.find(next);
+
+        ChainLink link{next, record->model.get(), CancellationToken(), false, {}, {}, {}, false};
+
+        bool converted = false;
+
+        for (PortIndex portIndex = 0; portIndex < record->inTypes.size(); ++portIndex) {
+            forEachConnection(next, PortType::In, portIndex, [&](ConnectionId const &cn) {
+                link.ports.emplace_back(cn.outPortIndex, cn.inPortIndex);
+
+                if (connectionConverter(cn))
+                    converted = true;
+            });
+        }
+
+        // The type converters are not required to be thread-safe, the
+        // data is converted when staged on the GUI thread.
+        if (converted)
+            break;
+
+        chain.push_back(std::move(link));
+
+        current = next;
+    }
+
+    return chain;
+}
+
+void DataFlowGraphModel::stageOutputs(NodeId const nodeId,
+                                      NodeDelegateModel::PortDataList const &outputs,
+                                      NodeId const skippedNode)
+{
+    NodeRecord *record = _nodes.find(nodeId);
+
+    for (auto const &output : outputs) {
+        // Every streamed update counts, even a repeated one.
+        if (record && _propagationMode != PropagationMode::Streaming
+            && !outputChanged(*record, output.first, output.second))
+            continue;
+
+        forEachConnection(nodeId,
+                          PortType::Out,
+                          output.first,
+                          [this, &output, skippedNode](ConnectionId const &cn) {
+                              if (cn.inNodeId == skippedNode)
+                                  return;
+
+                              std::shared_ptr<NodeData> nodeData = convertData(cn, output.second);
+
+                              if (_propagationMode == PropagationMode::Streaming) {
+                                  enqueueStreamData(cn, std::move(nodeData));
+                              } else {
+                                  stageInData(cn.inNodeId, cn.inPortIndex, std::move(nodeData));
+                              }
+                          });
+    }
+}
+
+bool DataFlowGraphModel::outputChanged(NodeRecord &record,
+                                       PortIndex const portIndex,
+                                       std::shared_ptr<NodeData> const &nodeData)
+{
+    if (portIndex >= record.outData.size())
+        return true;
+
+    std::shared_ptr<NodeData> &previous = record.outData[portIndex];
+
+    std::uint64_t &revision = record.outRevisions[portIndex];
+
+    bool unchanged = (previous && nodeData) ? previous->equals(*nodeData) : (previous == nodeData);
+
+    // The same object modified in place carries new data.
+    if (unchanged && nodeData && previous == nodeData)
+        unchanged = nodeData->revision() == revision;
+
+    previous = nodeData;
+    revision = nodeData ? nodeData->revision() : 0;
+
+    return !unchanged;
+}
+
+void DataFlowGraphModel::setCoalescingInterval(int const msec)
+{
+    _coalescingInterval = msec;
+
+    if (msec < 0) {
+        flushCoalescedUpdates();
+    } else if (_coalescingTimer.isActive()) {
+        _coalescingTimer.start(msec);
+    }
+}
+
+void DataFlowGraphModel::flushCoalescedUpdates()
+{
+    _coalescingTimer.stop();
+
+    if (_coalescedOutputs.empty())
+        return;
+
+    std::vector<std::pair<NodeId, PortIndex>> outputs;
+    outputs.swap(_coalescedOutputs);
+
+    for (auto const &output : outputs) {
+        NodeRecord *record = _nodes.find(output.first);
+
+        // A computing node delivers its outputs on completion.
+        if (!record || _runningNodes.count(output.first) > 0)
+            continue;
+
+        stageOutputs(output.first, {{output.second, record->model->outData(output.second)}});
+    }
+
+    runPropagationWave();
+}
+
+void DataFlowGraphModel::setStreamQueueCapacity(std::size_t const capacity)
+{
+    _streamQueueCapacity = std::max<std::size_t>(capacity, 1);
+
+    std::unordered_set<NodeId> producers;
+
+    for (auto &queue : _streamQueues) {
+        // Shrinking drops the oldest updates.
+        while (queue.second.size() > _streamQueueCapacity) {
+            queue.second.pop_front();
+        }
+
+        producers.insert(queue.first.outNodeId);
+    }
+
+    producers.insert(_throttledNodes.begin(), _throttledNodes.end());
+
+    for (NodeId const nodeId : producers) {
+        updateThrottling(nodeId);
+        _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+    }
+
+    runPropagationWave();
+}
+
+std::size_t DataFlowGraphModel::queueDepth(ConnectionId const connectionId) const
+{
+    auto it = _streamQueues.find(connectionId);
+
+    return (it != _streamQueues.end()) ? it->second.size() : 0;
+}
+
+void DataFlowGraphModel::runStreamingWave()
+{
+    if (_propagating)
+        return;
+
+    _propagating = true;
+
+    while (!_dirtyNodes.empty()) {
+        NodeId const nodeId = _dirtyNodes.top().second;
+        _dirtyNodes.pop();
+
+        if (!streamReady(nodeId))
+            continue;
+
+        NodeRecord *record = _nodes.find(nodeId);
+        NodeDelegateModel *model = record->model.get();
+
+        NodeDelegateModel::PortDataList inputs = takeStreamInputs(nodeId);
+
+        for (auto const &input : inputs) {
+            if (input.first < record->inData.size())
+                record->inData[input.first] = input.second;
+        }
+
+        completeInputs(*record, inputs);
+
+        Computation computation{nodeId, model, CancellationToken(), false, 0, {}, {}, {}};
+        computation.inputs = std::move(inputs);
+
+        NodeDelegateModel::ComputeTask task = model->computeTask(computation.inputs);
+
+        if (runsOnWorker(model, task)) {
+            computation.asyncTask = static_cast<bool>(task);
+            dispatchToWorker(std::move(computation), std::move(task));
+            continue;
+        }
+
+        NodeDelegateModel::PortDataList const outputs = captureOutputs(nodeId, model, [&]() {
+            model->setChangedInData(computation.inputs);
+        });
+
+        for (auto const &input : computation.inputs) {
+            Q_EMIT inPortDataWasSet(nodeId, PortType::In, input.first);
+        }
+
+        stageOutputs(nodeId, outputs);
+
+        // The node fires once per queued update.
+        _dirtyNodes.emplace(_topology.rank(nodeId), nodeId);
+    }
+
+    _propagating = false;
+}
+
+bool DataFlowGraphModel::streamReady(NodeId const nodeId) const
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    if (!record || _runningNodes.count(nodeId) > 0 || _throttledNodes.count(nodeId) > 0)
+        return false;
+
+    if (_stagedInData.count(nodeId) > 0)
+        return true;
+
+    bool queued = false;
+
+    for (PortIndex portIndex = 0; portIndex < record->inTypes.size(); ++portIndex) {
+        forEachConnection(nodeId, PortType::In, portIndex, [&](ConnectionId const &cn) {
+            auto it = _streamQueues.find(cn);
+            if (it != _streamQueues.end() && !it->second.empty())
+                queued = true;
+        });
+    }
+
+    return queued;
+}
+
+NodeDelegateModel::PortDataList DataFlowGraphModel::takeStreamInputs(NodeId const nodeId)
+{
+    NodeDelegateModel::PortDataList inputs;
+
+    // Data set directly on the input ports, e.g. by a new connection.
+    auto staged = _stagedInData.find(nodeId);
+    if (staged != _stagedInData.end()) {
+        inputs = std::move(staged->second);
+        _stagedInData.erase(staged);
+    }
+
+    std::vector<NodeId> producers;
+
+    NodeRecord const *record = _nodes.find(nodeId);
+
+    for (PortIndex portIndex = 0; portIndex < record->inTypes.size(); ++portIndex) {
+        forEachConnection(nodeId, PortType::In, portIndex, [&](ConnectionId const &cn) {
+            auto it = _streamQueues.find(cn);
+            if (it == _streamQueues.end() || it->second.empty())
+                return;
+
+            std::shared_ptr<NodeData> nodeData = std::move(it->second.front());
+            it->second.pop_front();
+
+            auto input = std::find_if(inputs.begin(), inputs.end(), [portIndex](auto const &i) {
+                return i.first == portIndex;
+            });
+
+            if (input != inputs.end()) {
+                input->second = std::move(nodeData);
+            } else {
+                inputs.emplace_back(portIndex, std::move(nodeData));
+            }
+
+            producers.push_back(cn.outNodeId);
+        });
+    }
+
+    // The producers may be able to fire again.
+    for (NodeId const producer : producers) {
+        updateThrottling(producer);
+        _dirtyNodes.emplace(_topology.rank(producer), producer);
+    }
+
+    return inputs;
+}
+
+void DataFlowGraphModel::enqueueStreamData(ConnectionId const &connectionId,
+                                           std::shared_ptr<NodeData> nodeData)
+{
+    std::deque<std::shared_ptr<NodeData>> &queue = _streamQueues[connectionId];
+
+    // Only a source ignoring the backpressure can overfill the queue.
+    if (queue.size() >= _streamQueueCapacity)
+        queue.pop_front();
+
+    queue.push_back(std::move(nodeData));
+
+    _dirtyNodes.emplace(_topology.rank(connectionId.inNodeId), connectionId.inNodeId);
+
+    if (queue.size() >= _streamQueueCapacity)
+        updateThrottling(connectionId.outNodeId);
+}
+
+void DataFlowGraphModel::updateThrottling(NodeId const nodeId)
+{
+    NodeRecord const *record = _nodes.find(nodeId);
+    if (!record)
+        return;
+
+    bool throttled = false;
+
+    for (PortIndex portIndex = 0; portIndex < record->outTypes.size(); ++portIndex) {
+        forEachConnection(nodeId, PortType::Out, portIndex, [&](ConnectionId const &cn) {
+            auto it = _streamQueues.find(cn);
+            if (it != _streamQueues.end() && it->second.size() >= _streamQueueCapacity)
+                throttled = true;
+        });
+    }
+
+    if (throttled == (_throttledNodes.count(nodeId) > 0))
+        return;
+
+    if (throttled) {
+        _throttledNodes.insert(nodeId);
+    } else {
+        _throttledNodes.erase(nodeId);
+    }
+
+    Q_EMIT record->model->backpressureChanged(throttled);
+}
+
+void DataFlowGraphModel::setMemoizationBudget(std::size_t const bytes)
+{
+    _outputCache.setBudget(bytes);
+}
+
+void DataFlowGraphModel::completeInputs(NodeRecord &record,
+                                        NodeDelegateModel::PortDataList &inputs)
+{
+    if (!record.staleInputs)
+        return;
+
+    record.staleInputs = false;
+
+    for (PortIndex portIndex = 0; portIndex < record.inData.size(); ++portIndex) {
+        bool const present = std::any_of(inputs.begin(), inputs.end(), [portIndex](auto const &i) {
+            return i.first == portIndex;
+        });
+
+        if (!present)
+            inputs.emplace_back(portIndex, record.inData[portIndex]);
+    }
+}
+
+std::uint64_t DataFlowGraphModel::inputFingerprint(NodeRecord const &record)
+{
+    // FNV-1a style mixing of the per-port fingerprints.
+    std::uint64_t constexpr Prime = 1099511628211ull;
+    std::uint64_t constexpr EmptyPort = 0x9e3779b97f4a7c15ull;
+
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (std::size_t port = 0; port < record.inData.size(); ++port) {
+        std::uint64_t value = EmptyPort;
+
+        if (auto const &data = record.inData[port]) {
+            value = data->fingerprint();
+
+            if (value == 0)
+                return 0;
+        }
+
+        hash = (hash ^ value) * Prime;
+        hash = (hash ^ port) * Prime;
+    }
+
+    return (hash != 0) ? hash : 1;
+}
+
+ExecutionPlan DataFlowGraphModel::compile(bool const fuse) const
+{
+    ExecutionPlan plan;
+
+    plan._revision = _graphRevision;
+
+    std::vector<NodeId> order;
+    order.reserve(_nodes.size());
+
+    for (auto const &entry : _nodes) {
+        order.push_back(entry.nodeId);
+    }
+
+    std::sort(order.begin(), order.end(), [this](NodeId const a, NodeId const b) {
+        return _topology.rank(a) < _topology.rank(b);
+    });
+
+    for (NodeId const nodeId : order) {
+        auto const outputCount = static_cast<std::uint32_t>(_nodes.find(nodeId)->outTypes.size());
+
+        plan._outputSlots[nodeId] = {static_cast<ExecutionPlan::SlotIndex>(plan._slotCount),
+                                     outputCount};
+        plan._slotCount += outputCount;
+    }
+
+    plan._steps.reserve(order.size());
+
+    for (NodeId const nodeId : order) {
+        NodeRecord const *record = _nodes.find(nodeId);
+
+        ExecutionPlan::Step step;
+        step.nodeId = nodeId;
+        step.model = record->model.get();
+        step.firstInput = static_cast<std::uint32_t>(plan._inputBindings.size());
+        step.inputCount = static_cast<std::uint32_t>(record->inTypes.size());
+        step.firstOutput = plan._outputSlots[nodeId].first;
+        step.outputCount = plan._outputSlots[nodeId].second;
+
+        for (PortIndex portIndex = 0; portIndex < step.inputCount; ++portIndex) {
+            ExecutionPlan::SlotIndex slot = ExecutionPlan::InvalidSlot;
+            TypeConverter const *converter = nullptr;
+
+            // With several connections on one port the last one wins.
+            forEachConnection(nodeId, PortType::In, portIndex, [&](ConnectionId const &cn) {
+                slot = plan.outputSlot(cn.outNodeId, cn.outPortIndex);
+                converter = connectionConverter(cn);
+            });
+
+            std::uint32_t converterIndex = ExecutionPlan::NoConverter;
+
+            if (converter) {
+                converterIndex = static_cast<std::uint32_t>(plan._converters.size());
+                plan._converters.push_back(*converter);
+            }
+
+            plan._inputBindings.push_back(
+                ExecutionPlan::InputBinding{portIndex, slot, converterIndex});
+        }
+
+        plan._maxInputCount = std::max<std::size_t>(plan._maxInputCount, step.inputCount);
+        plan._steps.push_back(step);
+        plan._recordPositions.push_back(_nodes.position(nodeId));
+    }
+
+    if (fuse)
+        fuseArithmetic(plan, order);
+
+    return plan;
+}
+
+void DataFlowGraphModel::fuseArithmetic(ExecutionPlan &plan, std::vector<NodeId> const &order) const
+{
+    using Instruction = ExecutionPlan::Instruction;
+
+    std::unordered_map<NodeId, FusableExpression> expressions;
+    std::unordered_map<NodeId, std::uint32_t> stepIndices;
+
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        NodeRecord const *record = _nodes.find(order[i]);
+
+        stepIndices[order[i]] = i;
+
+        if (record->inTypes.size() != 2 || record->outTypes.size() != 1)
+            continue;
+
+        // The kernels read the operands as they are, without conversion.
+        ExecutionPlan::Step const &step = plan._steps[i];
+
+        if (plan._inputBindings[step.firstInput].converter != ExecutionPlan::NoConverter
+            || plan._inputBindings[step.firstInput + 1].converter != ExecutionPlan::NoConverter)
+            continue;
+
+        FusableExpression expression = record->model->fusableExpression();
+
+        if (expression.operation != FusableExpression::Operation::None && expression.makeData)
+            expressions.emplace(order[i], std::move(expression));
+    }
+
+    // A fusable node feeding nothing but one fusable node is computed by
+    // the kernel of that node.
+    std::unordered_map<NodeId, NodeId> consumers;
+
+    for (auto const &expression : expressions) {
+        std::size_t count = 0;
+        NodeId consumer = InvalidNodeId;
+
+        forEachConnection(expression.first, PortType::Out, 0, [&](ConnectionId const &cn) {
+            ++count;
+            consumer = cn.inNodeId;
+        });
+
+        if (count == 1 && expressions.count(consumer) > 0)
+            consumers[expression.first] = consumer;
+    }
+
+    // A node of the tree being emitted and the operands gathered so far.
+    struct Frame
+    {
+        NodeId node;
+        PortIndex nextPort;
+        std::uint32_t operands[2];
+    };
+
+    std::vector<Frame> pending;
+
+    for (NodeId const nodeId : order) {
+        auto root = expressions.find(nodeId);
+
+        if (root == expressions.end() || consumers.count(nodeId) > 0)
+            continue;
+
+        ExecutionPlan::Kernel kernel{static_cast<std::uint32_t>(plan._instructions.size()),
+                                     0,
+                                     {},
+                                     root->second.makeData};
+
+        std::uint32_t registerCount = 0;
+
+        // Emits the instructions of the tree rooted at the node in
+        // post-order. A long chain of fused nodes would overflow the call
+        // stack with a recursion.
+        pending.clear();
+        pending.push_back(Frame{nodeId, 0, {0, 0}});
+
+        while (!pending.empty()) {
+            Frame &frame = pending.back();
+
+            if (frame.nextPort < 2) {
+                PortIndex const portIndex = frame.nextPort++;
+                NodeId const node = frame.node;
+                NodeId source = InvalidNodeId;
+
+                // The same connection as the one in the input binding.
+                forEachConnection(node, PortType::In, portIndex, [&](ConnectionId const &cn) {
+                    source = cn.outNodeId;
+                });
+
+                auto consumer = consumers.find(source);
+
+                if (consumer != consumers.end() && consumer->second == node) {
+                    pending.push_back(Frame{source, 0, {0, 0}});
+                    continue;
+                }
+
+                frame.operands[portIndex] = registerCount++;
+
+                ExecutionPlan::Step const &step = plan._steps[stepIndices[node]];
+                ExecutionPlan::InputBinding const &binding
+                    = plan._inputBindings[step.firstInput + portIndex];
+
+                plan._instructions.push_back(Instruction{Instruction::Opcode::Load,
+                                                         frame.operands[portIndex],
+                                                         0,
+                                                         0,
+                                                         binding.slot});
+                continue;
+            }
+
+            std::uint32_t const target = registerCount++;
+
+            plan._instructions.push_back(Instruction{toOpcode(expressions[frame.node].operation),
+                                                     target,
+                                                     frame.operands[0],
+                                                     frame.operands[1],
+                                                     ExecutionPlan::InvalidSlot});
+
+            NodeId const node = frame.node;
+
+            pending.pop_back();
+
+            // The result is the operand of the node waiting for it.
+            if (!pending.empty()) {
+                Frame &parent = pending.back();
+                parent.operands[parent.nextPort - 1] = target;
+
+                plan._steps[stepIndices[node]].fused = true;
+                kernel.fusedSteps.push_back(stepIndices[node]);
+            }
+        }
+
+        // A single node gains nothing from the kernel.
+        if (kernel.fusedSteps.empty()) {
+            plan._instructions.resize(kernel.firstInstruction);
+            continue;
+        }
+
+        kernel.instructionCount = static_cast<std::uint32_t>(plan._instructions.size()
+                                                             - kernel.firstInstruction);
+
+        plan._registerCount = std::max<std::size_t>(plan._registerCount, registerCount);
+
+        plan._steps[stepIndices[nodeId]].kernel = static_cast<std::uint32_t>(plan._kernels.size());
+        plan._kernels.push_back(std::move(kernel));
+    }
+}
+
+bool DataFlowGraphModel::execute(ExecutionPlan const &plan,
+                                 ExecutionPlan::Inputs const &inputs,
+                                 ExecutionPlan::Slots &slots)
+{
+    if (plan.revision() != _graphRevision)
+        return false;
+
+    // The workers may be using the delegates of the plan.
+    if (!_runningNodes.empty())
+        return false;
+
+    slots.assign(plan.slotCount(), nullptr);
+
+    _kernelRegisters.resize(std::max(_kernelRegisters.size(), plan.registerCount()));
+
+    auto const &steps = plan.steps();
+    auto const &bindings = plan.inputBindings();
+
+    // Nodes without inputs are not evaluated, their current outputs are
+    // used unless replaced by the given inputs.
+    for (auto const &step : steps) {
+        if (step.inputCount > 0)
+            continue;
+
+        for (std::uint32_t i = 0; i < step.outputCount; ++i) {
+            slots[step.firstOutput + i] = step.model->outData(i);
+        }
+    }
+
+    for (auto const &input : inputs) {
+        if (input.first < slots.size())
+            slots[input.first] = input.second;
+    }
+
+    // The records follow the evaluation, so the propagation afterwards
+    // compares against the outputs the delegates hold now.
+    auto syncOutputs = [&](std::size_t const stepIndex) {
+        ExecutionPlan::Step const &step = steps[stepIndex];
+        NodeRecord *record = &_nodes.at(plan._recordPositions[stepIndex]);
+
+        for (std::uint32_t i = 0; i < step.outputCount && i < record->outData.size(); ++i) {
+            std::shared_ptr<NodeData> const &outData = slots[step.firstOutput + i];
+
+            record->outData[i] = outData;
+            record->outRevisions[i] = outData ? outData->revision() : 0;
+        }
+
+        return record;
+    };
+
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        if (steps[i].inputCount == 0)
+            syncOutputs(i);
+    }
+
+    NodeDelegateModel::PortDataList inData;
+    inData.reserve(plan.maxInputCount());
+
+    auto runStep = [&](std::size_t const stepIndex) {
+        ExecutionPlan::Step const &step = steps[stepIndex];
+
+        inData.clear();
+
+        for (std::uint32_t i = step.firstInput; i < step.firstInput + step.inputCount; ++i) {
+            ExecutionPlan::InputBinding const &binding = bindings[i];
+
+            std::shared_ptr<NodeData> nodeData;
+
+            if (binding.slot != ExecutionPlan::InvalidSlot)
+                nodeData = slots[binding.slot];
+
+            if (nodeData && binding.converter != ExecutionPlan::NoConverter)
+                nodeData = plan.converters()[binding.converter](std::move(nodeData));
+
+            inData.emplace_back(binding.portIndex, std::move(nodeData));
+        }
+
+        {
+            // The outputs are collected below, no propagation is wanted.
+            QSignalBlocker const blocker(step.model);
+
+            step.model->setChangedInData(inData);
+        }
+
+        for (std::uint32_t i = 0; i < step.outputCount; ++i) {
+            slots[step.firstOutput + i] = step.model->outData(i);
+        }
+
+        NodeRecord *record = syncOutputs(stepIndex);
+
+        for (auto const &input : inData) {
+            if (input.first < record->inData.size())
+                record->inData[input.first] = input.second;
+        }
+
+        record->staleInputs = false;
+    };
+
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        ExecutionPlan::Step const &step = steps[i];
+
+        if (step.inputCount == 0 || step.fused)
+            continue;
+
+        if (step.kernel != ExecutionPlan::NoKernel) {
+            ExecutionPlan::Kernel const &kernel = plan.kernels()[step.kernel];
+
+            double value = 0.0;
+
+            ExecutionPlan::KernelStatus const status
+                = plan.runKernel(kernel, slots, _kernelRegisters, value);
+
+            if (status != ExecutionPlan::KernelStatus::Unsupported) {
+                std::shared_ptr<NodeData> result;
+
+                if (status == ExecutionPlan::KernelStatus::Value)
+                    result = kernel.makeData(value);
+
+                slots[step.firstOutput] = result;
+
+                {
+                    QSignalBlocker const blocker(step.model);
+
+                    step.model->setComputeResult({{0, std::move(result)}});
+                }
+
+                // The inputs of the node were not staged, the next delivery
+                // hands all of them over.
+                syncOutputs(i)->staleInputs = true;
+                continue;
+            }
+
+            for (std::uint32_t const fusedStep : kernel.fusedSteps) {
+                runStep(fusedStep);
+            }
+        }
+
+        runStep(i);
+    }
+
+    return true;
 }
 
 } // namespace QtNodes
@@ -35,6 +35,30 @@ DataFlowGraphicsScene::DataFlowGraphicsScene(DataFlowGraphModel &graphModel, QOb
     connect(&_graphModel,
             &DataFlowGraphModel::inPortDataWasSet,
             [this](NodeId const nodeId, PortType const, PortIndex const) { onNodeUpdated(nodeId); });
+
+    // Embedded widgets display the node state, keep such nodes evaluated
+    // in the lazy propagation mode.
+    connect(&_graphModel,
+            &DataFlowGraphModel::nodeCreated,
+            this,
+            &DataFlowGraphicsScene::observeEmbeddedWidget);
+
+    connect(&_graphModel,
+            &DataFlowGraphModel::nodesCreated,
+            this,
+            [this](std::vector<NodeId> const &nodeIds) {
+                for (NodeId const nodeId : nodeIds) {
+                    observeEmbeddedWidget(nodeId);
+                }
+            });
+
+    _graphModel.forEachNode([this](NodeId const nodeId) { observeEmbeddedWidget(nodeId); });
+}
+
+void DataFlowGraphicsScene::observeEmbeddedWidget(NodeId const nodeId)
+{
+    if (_graphModel.nodeWidget(nodeId))
+        _graphModel.setNodeObserved(nodeId, true);
 }
 
 // TODO constructor for an empyt scene?
@@ -97,16 +97,13 @@ void DefaultConnectionPainter::drawNormalLine(QPainter *painter, ConnectionGraph
 
         auto const cId = cgo.connectionId();
 
-        auto dataTypeOut = graphModel
-                               .portData(cId.outNodeId,
-                                         PortType::Out,
-                                         cId.outPortIndex,
-                                         PortRole::DataType)
-                               .value<NodeDataType>();
-
-        auto dataTypeIn
-            = graphModel.portData(cId.inNodeId, PortType::In, cId.inPortIndex, PortRole::DataType)
-                  .value<NodeDataType>();
+        NodeDataType const dataTypeOut = graphModel.portDataType(cId.outNodeId,
+                                                                 PortType::Out,
+                                                                 cId.outPortIndex);
+
+        NodeDataType const dataTypeIn = graphModel.portDataType(cId.inNodeId,
+                                                                PortType::In,
+                                                                cId.inPortIndex);
 
         useGradientColor = (dataTypeOut.id != dataTypeIn.id);
 
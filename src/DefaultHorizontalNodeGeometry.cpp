@@ -37,14 +37,14 @@ QRectF DefaultHorizontalNodeGeometry::boundingRect(NodeId const nodeId) const
 
 QSize DefaultHorizontalNodeGeometry::size(NodeId const nodeId) const
 {
-    return _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    return _graphModel.nodeSize(nodeId);
 }
 
 void DefaultHorizontalNodeGeometry::recomputeSize(NodeId const nodeId) const
 {
     unsigned int height = maxVerticalPortsExtent(nodeId);
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         height = std::max(height, static_cast<unsigned int>(w->height()));
     }
 
@@ -60,7 +60,7 @@ void DefaultHorizontalNodeGeometry::recomputeSize(NodeId const nodeId) const
 
     unsigned int width = inPortWidth + outPortWidth + 4 * _portSpasing;
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         width += w->width();
     }
 
@@ -87,7 +87,7 @@ QPointF DefaultHorizontalNodeGeometry::portPosition(NodeId const nodeId,
     totalHeight += step * portIndex;
     totalHeight += step / 2.0;
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In: {
@@ -121,7 +121,7 @@ QPointF DefaultHorizontalNodeGeometry::portTextPosition(NodeId const nodeId,
 
     p.setY(p.y() + rect.height() / 4.0);
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In:
@@ -141,28 +141,28 @@ QPointF DefaultHorizontalNodeGeometry::portTextPosition(NodeId const nodeId,
 
 QRectF DefaultHorizontalNodeGeometry::captionRect(NodeId const nodeId) const
 {
-    if (!_graphModel.nodeData<bool>(nodeId, NodeRole::CaptionVisible))
+    if (!_graphModel.nodeCaptionVisible(nodeId))
         return QRect();
 
-    QString name = _graphModel.nodeData<QString>(nodeId, NodeRole::Caption);
+    QString name = _graphModel.nodeCaption(nodeId);
 
     return _boldFontMetrics.boundingRect(name);
 }
 
 QPointF DefaultHorizontalNodeGeometry::captionPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
     return QPointF(0.5 * (size.width() - captionRect(nodeId).width()),
                    0.5 * _portSpasing + captionRect(nodeId).height());
 }
 
 QPointF DefaultHorizontalNodeGeometry::widgetPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int captionHeight = captionRect(nodeId).height();
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         // If the widget wants to use as much vertical space as possible,
         // place it immediately after the caption.
         if (w->sizePolicy().verticalPolicy() & QSizePolicy::ExpandFlag) {
@@ -178,7 +178,7 @@ QPointF DefaultHorizontalNodeGeometry::widgetPosition(NodeId const nodeId) const
 
 QRect DefaultHorizontalNodeGeometry::resizeHandleRect(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int rectSize = 7;
 
@@ -190,12 +190,10 @@ QRectF DefaultHorizontalNodeGeometry::portTextRect(NodeId const nodeId,
                                                    PortIndex const portIndex) const
 {
     QString s;
-    if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
-        s = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+    if (_graphModel.portCaptionVisible(nodeId, portType, portIndex)) {
+        s = _graphModel.portCaption(nodeId, portType, portIndex);
     } else {
-        auto portData = _graphModel.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-        s = portData.value<NodeDataType>().name;
+        s = _graphModel.portDataType(nodeId, portType, portIndex).name;
     }
 
     return _fontMetrics.boundingRect(s);
@@ -203,9 +201,9 @@ QRectF DefaultHorizontalNodeGeometry::portTextRect(NodeId const nodeId,
 
 unsigned int DefaultHorizontalNodeGeometry::maxVerticalPortsExtent(NodeId const nodeId) const
 {
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     unsigned int maxNumOfEntries = std::max(nInPorts, nOutPorts);
     unsigned int step = _portSize + _portSpasing;
@@ -218,24 +216,17 @@ unsigned int DefaultHorizontalNodeGeometry::maxPortsTextAdvance(NodeId const nod
 {
     unsigned int width = 0;
 
-    size_t const n = _graphModel
-                         .nodeData(nodeId,
-                                   (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                               : NodeRole::InPortCount)
-                         .toUInt();
+    size_t const n = _graphModel.portCount(nodeId, portType);
 
     for (PortIndex portIndex = 0ul; portIndex < n; ++portIndex) {
         QString name;
 
-        if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
-            name = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+        if (_graphModel.portCaptionVisible(nodeId, portType, portIndex)) {
+            name = _graphModel.portCaption(nodeId, portType, portIndex);
         } else {
-            NodeDataType portData = _graphModel.portData<NodeDataType>(nodeId,
-                                                                       portType,
-                                                                       portIndex,
-                                                                       PortRole::DataType);
+            NodeDataType const portDataType = _graphModel.portDataType(nodeId, portType, portIndex);
 
-            name = portData.name;
+            name = portDataType.name;
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -36,17 +36,13 @@ void DefaultNodePainter::paint(QPainter *painter, NodeGraphicsObject &ngo) const
 
 void DefaultNodePainter::drawNodeRect(QPainter *painter, NodeGraphicsObject &ngo) const
 {
-    AbstractGraphModel &model = ngo.graphModel();
-
     NodeId const nodeId = ngo.nodeId();
 
     AbstractNodeGeometry &geometry = ngo.nodeScene()->nodeGeometry();
 
     QSize size = geometry.size(nodeId);
 
-    QJsonDocument json = QJsonDocument::fromVariant(model.nodeData(nodeId, NodeRole::Style));
-
-    NodeStyle nodeStyle(json.object());
+    NodeStyle const &nodeStyle = ngo.nodeStyle();
 
     auto color = ngo.isSelected() ? nodeStyle.SelectedBoundaryColor : nodeStyle.NormalBoundaryColor;
 
@@ -80,8 +76,7 @@ void DefaultNodePainter::drawConnectionPoints(QPainter *painter, NodeGraphicsObj
     NodeId const nodeId = ngo.nodeId();
     AbstractNodeGeometry &geometry = ngo.nodeScene()->nodeGeometry();
 
-    QJsonDocument json = QJsonDocument::fromVariant(model.nodeData(nodeId, NodeRole::Style));
-    NodeStyle nodeStyle(json.object());
+    NodeStyle const &nodeStyle = ngo.nodeStyle();
 
     auto const &connectionStyle = StyleCollection::connectionStyle();
 
@@ -89,17 +84,12 @@ void DefaultNodePainter::drawConnectionPoints(QPainter *painter, NodeGraphicsObj
     auto reducedDiameter = diameter * 0.6;
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        size_t const n = model
-                             .nodeData(nodeId,
-                                       (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                                   : NodeRole::InPortCount)
-                             .toUInt();
+        size_t const n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
             QPointF p = geometry.portPosition(nodeId, portType, portIndex);
 
-            auto const &dataType = model.portData(nodeId, portType, portIndex, PortRole::DataType)
-                                       .value<NodeDataType>();
+            NodeDataType const dataType = model.portDataType(nodeId, portType, portIndex);
 
             double r = 1.0;
 
@@ -152,27 +142,18 @@ void DefaultNodePainter::drawFilledConnectionPoints(QPainter *painter, NodeGraph
     NodeId const nodeId = ngo.nodeId();
     AbstractNodeGeometry &geometry = ngo.nodeScene()->nodeGeometry();
 
-    QJsonDocument json = QJsonDocument::fromVariant(model.nodeData(nodeId, NodeRole::Style));
-    NodeStyle nodeStyle(json.object());
+    NodeStyle const &nodeStyle = ngo.nodeStyle();
 
     auto diameter = nodeStyle.ConnectionPointDiameter;
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        size_t const n = model
-                             .nodeData(nodeId,
-                                       (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                                   : NodeRole::InPortCount)
-                             .toUInt();
+        size_t const n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
             QPointF p = geometry.portPosition(nodeId, portType, portIndex);
 
-            auto const &connected = model.connections(nodeId, portType, portIndex);
-
-            if (!connected.empty()) {
-                auto const &dataType = model
-                                           .portData(nodeId, portType, portIndex, PortRole::DataType)
-                                           .value<NodeDataType>();
+            if (model.connectionCount(nodeId, portType, portIndex) > 0) {
+                NodeDataType const dataType = model.portDataType(nodeId, portType, portIndex);
 
                 auto const &connectionStyle = StyleCollection::connectionStyle();
                 if (connectionStyle.useDataDefinedColors()) {
@@ -196,18 +177,17 @@ void DefaultNodePainter::drawNodeCaption(QPainter *painter, NodeGraphicsObject &
     NodeId const nodeId = ngo.nodeId();
     AbstractNodeGeometry &geometry = ngo.nodeScene()->nodeGeometry();
 
-    if (!model.nodeData(nodeId, NodeRole::CaptionVisible).toBool())
+    if (!model.nodeCaptionVisible(nodeId))
         return;
 
-    QString const name = model.nodeData(nodeId, NodeRole::Caption).toString();
+    QString const name = model.nodeCaption(nodeId);
 
     QFont f = painter->font();
     f.setBold(true);
 
     QPointF position = geometry.captionPosition(nodeId);
 
-    QJsonDocument json = QJsonDocument::fromVariant(model.nodeData(nodeId, NodeRole::Style));
-    NodeStyle nodeStyle(json.object());
+    NodeStyle const &nodeStyle = ngo.nodeStyle();
 
     painter->setFont(f);
     painter->setPen(nodeStyle.FontColor);
@@ -223,33 +203,25 @@ void DefaultNodePainter::drawEntryLabels(QPainter *painter, NodeGraphicsObject &
     NodeId const nodeId = ngo.nodeId();
     AbstractNodeGeometry &geometry = ngo.nodeScene()->nodeGeometry();
 
-    QJsonDocument json = QJsonDocument::fromVariant(model.nodeData(nodeId, NodeRole::Style));
-    NodeStyle nodeStyle(json.object());
+    NodeStyle const &nodeStyle = ngo.nodeStyle();
 
     for (PortType portType : {PortType::Out, PortType::In}) {
-        unsigned int n = model.nodeData<unsigned int>(nodeId,
-                                                      (portType == PortType::Out)
-                                                          ? NodeRole::OutPortCount
-                                                          : NodeRole::InPortCount);
+        unsigned int n = model.portCount(nodeId, portType);
 
         for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
-            auto const &connected = model.connections(nodeId, portType, portIndex);
-
             QPointF p = geometry.portTextPosition(nodeId, portType, portIndex);
 
-            if (connected.empty())
+            if (model.connectionCount(nodeId, portType, portIndex) == 0)
                 painter->setPen(nodeStyle.FontColorFaded);
             else
                 painter->setPen(nodeStyle.FontColor);
 
             QString s;
 
-            if (model.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
-                s = model.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+            if (model.portCaptionVisible(nodeId, portType, portIndex)) {
+                s = model.portCaption(nodeId, portType, portIndex);
             } else {
-                auto portData = model.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-                s = portData.value<NodeDataType>().name;
+                s = model.portDataType(nodeId, portType, portIndex).name;
             }
 
             painter->drawText(p, s);
@@ -37,14 +37,14 @@ QRectF DefaultVerticalNodeGeometry::boundingRect(NodeId const nodeId) const
 
 QSize DefaultVerticalNodeGeometry::size(NodeId const nodeId) const
 {
-    return _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    return _graphModel.nodeSize(nodeId);
 }
 
 void DefaultVerticalNodeGeometry::recomputeSize(NodeId const nodeId) const
 {
     unsigned int height = _portSpasing; // maxHorizontalPortsExtent(nodeId);
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         height = std::max(height, static_cast<unsigned int>(w->height()));
     }
 
@@ -55,8 +55,8 @@ void DefaultVerticalNodeGeometry::recomputeSize(NodeId const nodeId) const
     height += _portSpasing;
     height += _portSpasing;
 
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     // Adding double step (top and bottom) to reserve space for port captions.
 
@@ -76,7 +76,7 @@ void DefaultVerticalNodeGeometry::recomputeSize(NodeId const nodeId) const
 
     unsigned int width = std::max(totalInPortsWidth, totalOutPortsWidth);
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         width = std::max(width, static_cast<unsigned int>(w->width()));
     }
 
@@ -96,13 +96,13 @@ QPointF DefaultVerticalNodeGeometry::portPosition(NodeId const nodeId,
 {
     QPointF result;
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In: {
         unsigned int inPortWidth = maxPortsTextAdvance(nodeId, PortType::In) + _portSpasing;
 
-        PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+        PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
         double x = (size.width() - (nInPorts - 1) * inPortWidth) / 2.0 + portIndex * inPortWidth;
 
@@ -115,7 +115,7 @@ QPointF DefaultVerticalNodeGeometry::portPosition(NodeId const nodeId,
 
     case PortType::Out: {
         unsigned int outPortWidth = maxPortsTextAdvance(nodeId, PortType::Out) + _portSpasing;
-        PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+        PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
         double x = (size.width() - (nOutPorts - 1) * outPortWidth) / 2.0 + portIndex * outPortWidth;
 
@@ -143,7 +143,7 @@ QPointF DefaultVerticalNodeGeometry::portTextPosition(NodeId const nodeId,
 
     p.setX(p.x() - rect.width() / 2.0);
 
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     switch (portType) {
     case PortType::In:
@@ -163,17 +163,17 @@ QPointF DefaultVerticalNodeGeometry::portTextPosition(NodeId const nodeId,
 
 QRectF DefaultVerticalNodeGeometry::captionRect(NodeId const nodeId) const
 {
-    if (!_graphModel.nodeData<bool>(nodeId, NodeRole::CaptionVisible))
+    if (!_graphModel.nodeCaptionVisible(nodeId))
         return QRect();
 
-    QString name = _graphModel.nodeData<QString>(nodeId, NodeRole::Caption);
+    QString name = _graphModel.nodeCaption(nodeId);
 
     return _boldFontMetrics.boundingRect(name);
 }
 
 QPointF DefaultVerticalNodeGeometry::captionPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int step = portCaptionsHeight(nodeId, PortType::In);
     step += _portSpasing;
@@ -185,11 +185,11 @@ QPointF DefaultVerticalNodeGeometry::captionPosition(NodeId const nodeId) const
 
 QPointF DefaultVerticalNodeGeometry::widgetPosition(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int captionHeight = captionRect(nodeId).height();
 
-    if (auto w = _graphModel.nodeData<QWidget *>(nodeId, NodeRole::Widget)) {
+    if (auto w = _graphModel.nodeWidget(nodeId)) {
         // If the widget wants to use as much vertical space as possible,
         // place it immediately after the caption.
         if (w->sizePolicy().verticalPolicy() & QSizePolicy::ExpandFlag) {
@@ -204,7 +204,7 @@ QPointF DefaultVerticalNodeGeometry::widgetPosition(NodeId const nodeId) const
 
 QRect DefaultVerticalNodeGeometry::resizeHandleRect(NodeId const nodeId) const
 {
-    QSize size = _graphModel.nodeData<QSize>(nodeId, NodeRole::Size);
+    QSize size = _graphModel.nodeSize(nodeId);
 
     unsigned int rectSize = 7;
 
@@ -216,12 +216,10 @@ QRectF DefaultVerticalNodeGeometry::portTextRect(NodeId const nodeId,
                                                  PortIndex const portIndex) const
 {
     QString s;
-    if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
-        s = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+    if (_graphModel.portCaptionVisible(nodeId, portType, portIndex)) {
+        s = _graphModel.portCaption(nodeId, portType, portIndex);
     } else {
-        auto portData = _graphModel.portData(nodeId, portType, portIndex, PortRole::DataType);
-
-        s = portData.value<NodeDataType>().name;
+        s = _graphModel.portDataType(nodeId, portType, portIndex).name;
     }
 
     return _fontMetrics.boundingRect(s);
@@ -229,9 +227,9 @@ QRectF DefaultVerticalNodeGeometry::portTextRect(NodeId const nodeId,
 
 unsigned int DefaultVerticalNodeGeometry::maxHorizontalPortsExtent(NodeId const nodeId) const
 {
-    PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+    PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
 
-    PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+    PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
 
     unsigned int maxNumOfEntries = std::max(nInPorts, nOutPorts);
     unsigned int step = _portSize + _portSpasing;
@@ -244,24 +242,17 @@ unsigned int DefaultVerticalNodeGeometry::maxPortsTextAdvance(NodeId const nodeI
 {
     unsigned int width = 0;
 
-    size_t const n = _graphModel
-                         .nodeData(nodeId,
-                                   (portType == PortType::Out) ? NodeRole::OutPortCount
-                                                               : NodeRole::InPortCount)
-                         .toUInt();
+    size_t const n = _graphModel.portCount(nodeId, portType);
 
     for (PortIndex portIndex = 0ul; portIndex < n; ++portIndex) {
         QString name;
 
-        if (_graphModel.portData<bool>(nodeId, portType, portIndex, PortRole::CaptionVisible)) {
-            name = _graphModel.portData<QString>(nodeId, portType, portIndex, PortRole::Caption);
+        if (_graphModel.portCaptionVisible(nodeId, portType, portIndex)) {
+            name = _graphModel.portCaption(nodeId, portType, portIndex);
         } else {
-            NodeDataType portData = _graphModel.portData<NodeDataType>(nodeId,
-                                                                       portType,
-                                                                       portIndex,
-                                                                       PortRole::DataType);
+            NodeDataType const portDataType = _graphModel.portDataType(nodeId, portType, portIndex);
 
-            name = portData.name;
+            name = portDataType.name;
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -281,9 +272,9 @@ unsigned int DefaultVerticalNodeGeometry::portCaptionsHeight(NodeId const nodeId
 
     switch (portType) {
     case PortType::In: {
-        PortCount nInPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::InPortCount);
+        PortCount nInPorts = _graphModel.portCount(nodeId, PortType::In);
         for (PortIndex i = 0; i < nInPorts; ++i) {
-            if (_graphModel.portData<bool>(nodeId, PortType::In, i, PortRole::CaptionVisible)) {
+            if (_graphModel.portCaptionVisible(nodeId, PortType::In, i)) {
                 h += _portSpasing;
                 break;
             }
@@ -292,9 +283,9 @@ unsigned int DefaultVerticalNodeGeometry::portCaptionsHeight(NodeId const nodeId
     }
 
     case PortType::Out: {
-        PortCount nOutPorts = _graphModel.nodeData<PortCount>(nodeId, NodeRole::OutPortCount);
+        PortCount nOutPorts = _graphModel.portCount(nodeId, PortType::Out);
         for (PortIndex i = 0; i < nOutPorts; ++i) {
-            if (_graphModel.portData<bool>(nodeId, PortType::Out, i, PortRole::CaptionVisible)) {
+            if (_graphModel.portCaptionVisible(nodeId, PortType::Out, i)) {
                 h += _portSpasing;
                 break;
             }
@@ -0,0 +1,70 @@
+#include "ExecutionPlan.hpp"
+
+namespace QtNodes {
+
+ExecutionPlan::SlotIndex ExecutionPlan::outputSlot(NodeId const nodeId,
+                                                   PortIndex const portIndex) const
+{
+    auto it = _outputSlots.find(nodeId);
+
+    if (it == _outputSlots.end() || portIndex >= it->second.second)
+        return InvalidSlot;
+
+    return it->second.first + portIndex;
+}
+
+ExecutionPlan::KernelStatus ExecutionPlan::runKernel(Kernel const &kernel,
+                                                     Slots const &slots,
+                                                     std::vector<double> &registers,
+                                                     double &value) const
+{
+    Instruction const *instruction = _instructions.data() + kernel.firstInstruction;
+    Instruction const *const end = instruction + kernel.instructionCount;
+
+    for (; instruction != end; ++instruction) {
+        double &target = registers[instruction->target];
+        double const lhs = registers[instruction->lhs];
+        double const rhs = registers[instruction->rhs];
+
+        switch (instruction->opcode) {
+        case Instruction::Opcode::Load: {
+            NodeData const *data = (instruction->slot != InvalidSlot)
+                                       ? slots[instruction->slot].get()
+                                       : nullptr;
+
+            if (!data)
+                return KernelStatus::Empty;
+
+            if (!data->scalarValue(target))
+                return KernelStatus::Unsupported;
+
+            break;
+        }
+
+        case Instruction::Opcode::Add:
+            target = lhs + rhs;
+            break;
+
+        case Instruction::Opcode::Subtract:
+            target = lhs - rhs;
+            break;
+
+        case Instruction::Opcode::Multiply:
+            target = lhs * rhs;
+            break;
+
+        case Instruction::Opcode::Divide:
+            if (rhs == 0.0)
+                return KernelStatus::Empty;
+
+            target = lhs / rhs;
+            break;
+        }
+    }
+
+    value = registers[(end - 1)->target];
+
+    return KernelStatus::Value;
+}
+
+} // namespace QtNodes
@@ -41,6 +41,30 @@ ConnectionPolicy NodeDelegateModel::portConnectionPolicy(PortType portType, Port
     return result;
 }
 
+void NodeDelegateModel::setChangedInData(PortDataList const &inputs)
+{
+    for (auto const &input : inputs) {
+        setInData(input.second, input.first);
+    }
+}
+
+NodeDelegateModel::ComputeTask NodeDelegateModel::computeTask(PortDataList const &)
+{
+    return ComputeTask();
+}
+
+void NodeDelegateModel::setComputeResult(PortDataList const &)
+{
+    _acceptsComputeResult = false;
+}
+
+void NodeDelegateModel::inputsInvalidated()
+{
+    for (PortIndex port = 0; port < nPorts(PortType::In); ++port) {
+        setInData(nullptr, port);
+    }
+}
+
 NodeStyle const &NodeDelegateModel::nodeStyle() const
 {
     return _nodeStyle;
@@ -49,6 +73,8 @@ NodeStyle const &NodeDelegateModel::nodeStyle() const
 void NodeDelegateModel::setNodeStyle(NodeStyle const &style)
 {
     _nodeStyle = style;
+
+    Q_EMIT nodeStyleUpdated();
 }
 
 } // namespace QtNodes
@@ -3,9 +3,14 @@
 #include <QtCore/QFile>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
+
+using QtNodes::DataTypeId;
 using QtNodes::NodeDataType;
 using QtNodes::NodeDelegateModel;
 using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::TypeConverter;
+using QtNodes::TypeConverterId;
 
 std::unique_ptr<NodeDelegateModel> NodeDelegateModelRegistry::create(QString const &modelName)
 {
@@ -34,3 +39,87 @@ NodeDelegateModelRegistry::CategoriesSet const &NodeDelegateModelRegistry::categ
 {
     return _categories;
 }
+
+DataTypeId NodeDelegateModelRegistry::dataTypeId(QString const &typeId)
+{
+    auto it = _dataTypeIds.find(typeId);
+
+    if (it != _dataTypeIds.end())
+        return it->second;
+
+    std::size_t const n = _dataTypeIds.size();
+    DataTypeId const newId = static_cast<DataTypeId>(n);
+
+    // Double the capacity keeping the old cells, the unused ones are
+    // incompatible already.
+    if (n == _typeStride) {
+        std::size_t const stride = std::max<std::size_t>(8, 2 * _typeStride);
+
+        std::vector<std::uint32_t> table(stride * stride, Incompatible);
+
+        for (std::size_t row = 0; row < n; ++row) {
+            std::copy_n(_typeCompatibility.begin() + row * _typeStride,
+                        n,
+                        table.begin() + row * stride);
+        }
+
+        _typeCompatibility = std::move(table);
+        _typeStride = stride;
+    }
+
+    _typeCompatibility[newId * _typeStride + newId] = Compatible;
+    _dataTypeIds[typeId] = newId;
+
+    return newId;
+}
+
+DataTypeId NodeDelegateModelRegistry::findDataTypeId(QString const &typeId) const
+{
+    auto it = _dataTypeIds.find(typeId);
+
+    return (it != _dataTypeIds.end()) ? it->second : QtNodes::InvalidDataTypeId;
+}
+
+void NodeDelegateModelRegistry::registerTypeConverter(TypeConverterId const &id,
+                                                      TypeConverter typeConverter)
+{
+    DataTypeId const outType = dataTypeId(id.first);
+    DataTypeId const inType = dataTypeId(id.second);
+
+    std::uint32_t &cell = _typeCompatibility[outType * _typeStride + inType];
+
+    if (!typeConverter) {
+        if (cell >= FirstConverter)
+            eraseTypeConverter(cell);
+
+        cell = Compatible;
+    } else if (cell >= FirstConverter) {
+        _typeConverters[cell - FirstConverter] = std::move(typeConverter);
+    } else if (!_freeConverterSlots.empty()) {
+        std::uint32_t const slot = _freeConverterSlots.back();
+        _freeConverterSlots.pop_back();
+
+        _typeConverters[slot] = std::move(typeConverter);
+        cell = slot + FirstConverter;
+    } else {
+        _typeConverters.push_back(std::move(typeConverter));
+        cell = static_cast<std::uint32_t>(_typeConverters.size() - 1 + FirstConverter);
+    }
+}
+
+void NodeDelegateModelRegistry::eraseTypeConverter(std::uint32_t const cell)
+{
+    std::uint32_t const slot = cell - FirstConverter;
+
+    // The other cells keep their slots, this one is reused later.
+    _typeConverters[slot] = TypeConverter();
+    _freeConverterSlots.push_back(slot);
+}
+
+TypeConverter NodeDelegateModelRegistry::getTypeConverter(NodeDataType const &d1,
+                                                          NodeDataType const &d2) const
+{
+    TypeConverter const *converter = typeConverter(findDataTypeId(d1.id), findDataTypeId(d2.id));
+
+    return converter ? *converter : TypeConverter();
+}
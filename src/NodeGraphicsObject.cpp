@@ -33,21 +33,7 @@ NodeGraphicsObject::NodeGraphicsObject(BasicGraphicsScene &scene, NodeId nodeId)
 
     setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
-    QJsonObject nodeStyleJson = _graphModel.nodeData(_nodeId, NodeRole::Style).toJsonObject();
-
-    NodeStyle nodeStyle(nodeStyleJson);
-
-    if(nodeStyle.ShadowEnabled)
-    {
-        auto effect = new QGraphicsDropShadowEffect;
-        effect->setOffset(4, 4);
-        effect->setBlurRadius(20);
-        effect->setColor(nodeStyle.ShadowColor);
-
-        setGraphicsEffect(effect);
-    }
-
-    setOpacity(nodeStyle.Opacity);
+    updateNodeStyle();
 
     setAcceptHoverEvents(true);
 
@@ -57,7 +43,7 @@ NodeGraphicsObject::NodeGraphicsObject(BasicGraphicsScene &scene, NodeId nodeId)
 
     nodeScene()->nodeGeometry().recomputeSize(_nodeId);
 
-    QPointF const pos = _graphModel.nodeData<QPointF>(_nodeId, NodeRole::Position);
+    QPointF const pos = _graphModel.nodePosition(_nodeId);
 
     setPos(pos);
 
@@ -90,7 +76,7 @@ void NodeGraphicsObject::embedQWidget()
     AbstractNodeGeometry &geometry = nodeScene()->nodeGeometry();
     geometry.recomputeSize(_nodeId);
 
-    if (auto w = _graphModel.nodeData(_nodeId, NodeRole::Widget).value<QWidget *>()) {
+    if (auto w = _graphModel.nodeWidget(_nodeId)) {
         _proxyWidget = new QGraphicsProxyWidget(this);
 
         _proxyWidget->setWidget(w);
@@ -140,16 +126,39 @@ void NodeGraphicsObject::setGeometryChanged()
     prepareGeometryChange();
 }
 
+void NodeGraphicsObject::updateNodeStyle()
+{
+    _nodeStyle = _graphModel.nodeStyle(_nodeId);
+
+    if (_nodeStyle.ShadowEnabled) {
+        auto effect = qobject_cast<QGraphicsDropShadowEffect *>(graphicsEffect());
+
+        if (!effect) {
+            effect = new QGraphicsDropShadowEffect;
+            effect->setOffset(4, 4);
+            effect->setBlurRadius(20);
+
+            setGraphicsEffect(effect);
+        }
+
+        effect->setColor(_nodeStyle.ShadowColor);
+    } else {
+        setGraphicsEffect(nullptr);
+    }
+
+    setOpacity(_nodeStyle.Opacity);
+}
+
 void NodeGraphicsObject::moveConnections() const
 {
-    auto const &connected = _graphModel.allConnectionIds(_nodeId);
+    BasicGraphicsScene *scene = nodeScene();
 
-    for (auto &cnId : connected) {
-        auto cgo = nodeScene()->connectionGraphicsObject(cnId);
+    _graphModel.forEachConnection(_nodeId, [scene](ConnectionId const &cnId) {
+        auto cgo = scene->connectionGraphicsObject(cnId);
 
         if (cgo)
             cgo->move();
-    }
+    });
 }
 
 void NodeGraphicsObject::reactToConnection(ConnectionGraphicsObject const *cgo)
@@ -207,12 +216,9 @@ void NodeGraphicsObject::mousePressEvent(QGraphicsSceneMouseEvent *event)
         } else // initialize new Connection
         {
             if (portToCheck == PortType::Out) {
-                auto const outPolicy = _graphModel
-                                           .portData(_nodeId,
-                                                     portToCheck,
-                                                     portIndex,
-                                                     PortRole::ConnectionPolicyRole)
-                                           .value<ConnectionPolicy>();
+                auto const outPolicy = _graphModel.portConnectionPolicy(_nodeId,
+                                                                        portToCheck,
+                                                                        portIndex);
 
                 if (!connected.empty() && outPolicy == ConnectionPolicy::One) {
                     for (auto &cnId : connected) {
@@ -257,7 +263,7 @@ void NodeGraphicsObject::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
     if (_nodeState.resizing()) {
         auto diff = event->pos() - event->lastPos();
 
-        if (auto w = _graphModel.nodeData<QWidget *>(_nodeId, NodeRole::Widget)) {
+        if (auto w = _graphModel.nodeWidget(_nodeId)) {
             prepareGeometryChange();
 
             auto oldSize = w->size();
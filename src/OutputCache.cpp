@@ -0,0 +1,113 @@
+#include "OutputCache.hpp"
+
+#include <iterator>
+
+namespace QtNodes {
+
+void OutputCache::setBudget(std::size_t const bytes)
+{
+    _budget = bytes;
+
+    evict();
+}
+
+NodeDelegateModel::PortDataList const *OutputCache::find(NodeId const nodeId,
+                                                         std::uint64_t const fingerprint)
+{
+    auto it = _index.find(Key{nodeId, fingerprint});
+
+    if (it == _index.end()) {
+        ++_misses;
+        return nullptr;
+    }
+
+    ++_hits;
+
+    _entries.splice(_entries.begin(), _entries, it->second);
+
+    return &it->second->outputs;
+}
+
+void OutputCache::insert(NodeId const nodeId,
+                         std::uint64_t const fingerprint,
+                         NodeDelegateModel::PortDataList outputs)
+{
+    if (_budget == 0)
+        return;
+
+    std::size_t bytes = sizeof(Entry);
+
+    for (auto const &output : outputs) {
+        if (output.second)
+            bytes += output.second->byteSize();
+    }
+
+    // An entry larger than the whole budget would evict everything else.
+    if (bytes > _budget)
+        return;
+
+    Key const key{nodeId, fingerprint};
+
+    auto it = _index.find(key);
+    if (it != _index.end())
+        erase(it->second);
+
+    _entries.push_front(Entry{key, std::move(outputs), bytes});
+    _index[key] = _entries.begin();
+    _nodeEntries[nodeId].insert(fingerprint);
+    _usedBytes += bytes;
+
+    evict();
+}
+
+void OutputCache::invalidateNode(NodeId const nodeId)
+{
+    auto node = _nodeEntries.find(nodeId);
+    if (node == _nodeEntries.end())
+        return;
+
+    std::unordered_set<std::uint64_t> const fingerprints = std::move(node->second);
+    _nodeEntries.erase(node);
+
+    for (std::uint64_t const fingerprint : fingerprints) {
+        auto it = _index.find(Key{nodeId, fingerprint});
+
+        _usedBytes -= it->second->bytes;
+        _entries.erase(it->second);
+        _index.erase(it);
+    }
+}
+
+void OutputCache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _nodeEntries.clear();
+    _usedBytes = 0;
+}
+
+void OutputCache::erase(EntryList::iterator const it)
+{
+    Key const key = it->key;
+
+    auto node = _nodeEntries.find(key.first);
+    if (node != _nodeEntries.end()) {
+        node->second.erase(key.second);
+
+        if (node->second.empty())
+            _nodeEntries.erase(node);
+    }
+
+    _usedBytes -= it->bytes;
+    _index.erase(key);
+    _entries.erase(it);
+}
+
+void OutputCache::evict()
+{
+    while (_usedBytes > _budget && !_entries.empty()) {
+        erase(std::prev(_entries.end()));
+    }
+}
+
+} // namespace QtNodes
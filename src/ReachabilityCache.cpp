@@ -0,0 +1,219 @@
+#include "ReachabilityCache.hpp"
+
+#include "TopologicalOrder.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+std::unordered_set<NodeId> ReachabilityCache::reachable(NodeId const nodeId,
+                                                        Direction const direction,
+                                                        unsigned int const depth) const
+{
+    Entry const &entry = lookup(nodeId, direction, depth);
+
+    std::unordered_set<NodeId> result;
+
+    entry.nodes.forEach([&](std::uint32_t const slot) { result.insert(_slotNodes[slot]); });
+
+    return result;
+}
+
+bool ReachabilityCache::contains(NodeId const nodeId,
+                                 Direction const direction,
+                                 NodeId const target,
+                                 unsigned int const depth) const
+{
+    Entry const &entry = lookup(nodeId, direction, depth);
+
+    std::uint32_t slot = 0;
+
+    return findSlot(target, slot) && entry.nodes.contains(slot);
+}
+
+void ReachabilityCache::collect(NodeId const nodeId,
+                                Direction const direction,
+                                NodeBitSet &nodes) const
+{
+    nodes.insert(slotOf(nodeId));
+    nodes.unite(lookup(nodeId, direction, UnlimitedDepth).nodes);
+}
+
+bool ReachabilityCache::contains(NodeBitSet const &nodes, NodeId const nodeId) const
+{
+    std::uint32_t slot = 0;
+
+    return findSlot(nodeId, slot) && nodes.contains(slot);
+}
+
+ReachabilityCache::Entry const &ReachabilityCache::lookup(NodeId const nodeId,
+                                                          Direction const direction,
+                                                          unsigned int const depth) const
+{
+    std::uint64_t const entryKey = key(nodeId, direction, depth);
+
+    auto it = _index.find(entryKey);
+    if (it != _index.end()) {
+        _entries.splice(_entries.begin(), _entries, it->second);
+
+        return _entries.front();
+    }
+
+    Entry entry{entryKey, nodeId, direction, NodeBitSet()};
+
+    // Breadth-first search, one frontier per depth level.
+    std::vector<NodeId> frontier{nodeId};
+    std::vector<NodeId> next;
+
+    for (unsigned int level = 0; level < depth && !frontier.empty(); ++level) {
+        next.clear();
+
+        for (NodeId const current : frontier) {
+            auto visit = [&](NodeId const neighbour) {
+                if (neighbour == nodeId)
+                    return;
+
+                std::uint32_t const slot = slotOf(neighbour);
+
+                if (!entry.nodes.contains(slot)) {
+                    entry.nodes.insert(slot);
+                    next.push_back(neighbour);
+                }
+            };
+
+            if (direction == Direction::Downstream) {
+                _graph.forEachSuccessor(current, visit);
+            } else {
+                _graph.forEachPredecessor(current, visit);
+            }
+        }
+
+        frontier.swap(next);
+    }
+
+    _entries.push_front(std::move(entry));
+    _index.emplace(entryKey, _entries.begin());
+
+    while (_entries.size() > _capacity) {
+        erase(std::prev(_entries.end()));
+    }
+
+    return _entries.front();
+}
+
+void ReachabilityCache::invalidateEdge(NodeId const from, NodeId const to)
+{
+    std::uint32_t fromSlot = 0;
+    std::uint32_t toSlot = 0;
+
+    bool const fromCached = findSlot(from, fromSlot);
+    bool const toCached = findSlot(to, toSlot);
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        Entry const &entry = *it;
+
+        bool const affected = (entry.direction == Direction::Downstream)
+                                  ? (entry.nodeId == from
+                                     || (fromCached && entry.nodes.contains(fromSlot)))
+                                  : (entry.nodeId == to
+                                     || (toCached && entry.nodes.contains(toSlot)));
+
+        auto const current = it++;
+
+        if (affected)
+            erase(current);
+    }
+}
+
+void ReachabilityCache::invalidateNode(NodeId const nodeId)
+{
+    std::uint32_t slot = 0;
+
+    bool const cached = findSlot(nodeId, slot);
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto const current = it++;
+
+        if (current->nodeId == nodeId || (cached && current->nodes.contains(slot)))
+            erase(current);
+    }
+
+    // No result refers to the slot any more, so it can be reused.
+    if (cached) {
+        _slots.erase(nodeId);
+        _slotNodes[slot] = InvalidNodeId;
+        _freeSlots.push_back(slot);
+    }
+}
+
+void ReachabilityCache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _slots.clear();
+    _slotNodes.clear();
+    _freeSlots.clear();
+}
+
+void ReachabilityCache::setCapacity(std::size_t const capacity)
+{
+    _capacity = std::max<std::size_t>(capacity, 1);
+
+    while (_entries.size() > _capacity) {
+        erase(std::prev(_entries.end()));
+    }
+}
+
+void ReachabilityCache::erase(EntryList::iterator const it) const
+{
+    _index.erase(it->key);
+    _entries.erase(it);
+}
+
+std::uint32_t ReachabilityCache::slotOf(NodeId const nodeId) const
+{
+    auto it = _slots.find(nodeId);
+    if (it != _slots.end())
+        return it->second;
+
+    std::uint32_t slot = 0;
+
+    if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+
+        _slotNodes[slot] = nodeId;
+    } else {
+        slot = static_cast<std::uint32_t>(_slotNodes.size());
+
+        _slotNodes.push_back(nodeId);
+    }
+
+    _slots.emplace(nodeId, slot);
+
+    return slot;
+}
+
+bool ReachabilityCache::findSlot(NodeId const nodeId, std::uint32_t &slot) const
+{
+    auto it = _slots.find(nodeId);
+    if (it == _slots.end())
+        return false;
+
+    slot = it->second;
+
+    return true;
+}
+
+std::uint64_t ReachabilityCache::key(NodeId const nodeId,
+                                     Direction const direction,
+                                     unsigned int depth)
+{
+    // Any depth above this limit already covers every possible path.
+    depth = std::min(depth, 0x7fffffffu);
+
+    return (std::uint64_t(nodeId) << 32) | (std::uint64_t(depth) << 1)
+           | (direction == Direction::Downstream ? 1u : 0u);
+}
+
+} // namespace QtNodes
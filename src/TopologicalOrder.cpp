@@ -0,0 +1,225 @@
+#include "TopologicalOrder.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace QtNodes {
+
+void TopologicalOrder::addNode(NodeId const nodeId)
+{
+    if (_ranks.find(nodeId) == _ranks.end())
+        _ranks[nodeId] = _nextRank++;
+}
+
+void TopologicalOrder::removeNode(NodeId const nodeId)
+{
+    auto succIt = _successors.find(nodeId);
+    if (succIt != _successors.end()) {
+        for (auto const &edge : succIt->second) {
+            _predecessors[edge.first].erase(nodeId);
+        }
+        _successors.erase(succIt);
+    }
+
+    auto predIt = _predecessors.find(nodeId);
+    if (predIt != _predecessors.end()) {
+        for (auto const &edge : predIt->second) {
+            _successors[edge.first].erase(nodeId);
+        }
+        _predecessors.erase(predIt);
+    }
+
+    _ranks.erase(nodeId);
+}
+
+bool TopologicalOrder::contains(NodeId const nodeId) const
+{
+    return _ranks.find(nodeId) != _ranks.end();
+}
+
+bool TopologicalOrder::addEdge(NodeId const from, NodeId const to)
+{
+    if (from == to || !contains(from) || !contains(to))
+        return false;
+
+    auto &successors = _successors[from];
+
+    auto it = successors.find(to);
+    if (it != successors.end()) {
+        ++it->second;
+        ++_predecessors[to][from];
+        return true;
+    }
+
+    std::size_t const lowerBound = _ranks[to];
+    std::size_t const upperBound = _ranks[from];
+
+    if (lowerBound < upperBound) {
+        std::vector<NodeId> forward;
+        if (!collectRegion(to, from, _successors, lowerBound, upperBound, forward))
+            return false;
+
+        std::vector<NodeId> backward;
+        collectRegion(from, InvalidNodeId, _predecessors, lowerBound, upperBound, backward);
+
+        reorder(backward, forward);
+    }
+
+    successors[to] = 1;
+    _predecessors[to][from] = 1;
+
+    return true;
+}
+
+void TopologicalOrder::removeEdge(NodeId const from, NodeId const to)
+{
+    auto succIt = _successors.find(from);
+    if (succIt == _successors.end())
+        return;
+
+    auto edgeIt = succIt->second.find(to);
+    if (edgeIt == succIt->second.end())
+        return;
+
+    if (--edgeIt->second > 0) {
+        --_predecessors[to][from];
+        return;
+    }
+
+    succIt->second.erase(edgeIt);
+    _predecessors[to].erase(from);
+}
+
+bool TopologicalOrder::wouldCreateCycle(NodeId const from, NodeId const to) const
+{
+    if (from == to)
+        return true;
+
+    auto fromIt = _ranks.find(from);
+    auto toIt = _ranks.find(to);
+
+    if (fromIt == _ranks.end() || toIt == _ranks.end())
+        return false;
+
+    // A consistent edge can never close a cycle.
+    if (toIt->second > fromIt->second)
+        return false;
+
+    std::vector<NodeId> region;
+
+    return !collectRegion(to, from, _successors, toIt->second, fromIt->second, region);
+}
+
+std::size_t TopologicalOrder::rank(NodeId const nodeId) const
+{
+    auto it = _ranks.find(nodeId);
+
+    return (it != _ranks.end()) ? it->second : std::numeric_limits<std::size_t>::max();
+}
+
+void TopologicalOrder::forEachSuccessor(NodeId const nodeId, NodeVisitor const visitor) const
+{
+    auto it = _successors.find(nodeId);
+    if (it == _successors.end())
+        return;
+
+    for (auto const &edge : it->second) {
+        visitor(edge.first);
+    }
+}
+
+void TopologicalOrder::forEachPredecessor(NodeId const nodeId, NodeVisitor const visitor) const
+{
+    auto it = _predecessors.find(nodeId);
+    if (it == _predecessors.end())
+        return;
+
+    for (auto const &edge : it->second) {
+        visitor(edge.first);
+    }
+}
+
+void TopologicalOrder::clear()
+{
+    _ranks.clear();
+    _successors.clear();
+    _predecessors.clear();
+    _nextRank = 0;
+}
+
+bool TopologicalOrder::collectRegion(NodeId const start,
+                                     NodeId const target,
+                                     Adjacency const &adjacency,
+                                     std::size_t const lowerBound,
+                                     std::size_t const upperBound,
+                                     std::vector<NodeId> &region) const
+{
+    std::unordered_set<NodeId> visited;
+    std::vector<NodeId> stack{start};
+
+    visited.insert(start);
+
+    while (!stack.empty()) {
+        NodeId const nodeId = stack.back();
+        stack.pop_back();
+
+        region.push_back(nodeId);
+
+        auto it = adjacency.find(nodeId);
+        if (it == adjacency.end())
+            continue;
+
+        for (auto const &edge : it->second) {
+            NodeId const next = edge.first;
+
+            if (next == target)
+                return false;
+
+            std::size_t const nextRank = _ranks.at(next);
+
+            // Nodes outside of the affected region keep their ranks.
+            if (nextRank <= lowerBound || nextRank >= upperBound)
+                continue;
+
+            if (visited.insert(next).second)
+                stack.push_back(next);
+        }
+    }
+
+    return true;
+}
+
+void TopologicalOrder::reorder(std::vector<NodeId> &backward, std::vector<NodeId> &forward)
+{
+    auto byRank = [this](NodeId const a, NodeId const b) { return _ranks[a] < _ranks[b]; };
+
+    std::sort(backward.begin(), backward.end(), byRank);
+    std::sort(forward.begin(), forward.end(), byRank);
+
+    std::vector<std::size_t> pool;
+    pool.reserve(backward.size() + forward.size());
+
+    for (NodeId const nodeId : backward) {
+        pool.push_back(_ranks[nodeId]);
+    }
+
+    for (NodeId const nodeId : forward) {
+        pool.push_back(_ranks[nodeId]);
+    }
+
+    std::sort(pool.begin(), pool.end());
+
+    // Upstream part of the region goes first, keeping the relative order
+    // inside of both parts.
+    std::size_t i = 0;
+
+    for (NodeId const nodeId : backward) {
+        _ranks[nodeId] = pool[i++];
+    }
+
+    for (NodeId const nodeId : forward) {
+        _ranks[nodeId] = pool[i++];
+    }
+}
+
+} // namespace QtNodes
@@ -14,6 +14,7 @@
 #include <QtWidgets/QGraphicsObject>
 
 #include <typeinfo>
+#include <vector>
 
 namespace QtNodes {
 
@@ -59,32 +60,49 @@ static void insertSerializedItems(QJsonObject const &json, BasicGraphicsScene *s
 
     QJsonArray const &nodesJsonArray = json["nodes"].toArray();
 
-    for (QJsonValue node : nodesJsonArray) {
-        QJsonObject obj = node.toObject();
+    QJsonArray const &connJsonArray = json["connections"].toArray();
 
-        graphModel.loadNode(obj);
+    std::vector<ConnectionId> restoredConnections;
+    restoredConnections.reserve(connJsonArray.size());
 
-        auto id = obj["id"].toInt();
-        scene->nodeGraphicsObject(id)->setZValue(1.0);
-        scene->nodeGraphicsObject(id)->setSelected(true);
-    }
+    {
+        // The scene builds all the graphics objects in one go when the
+        // batch is closed.
+        GraphModelBatch batch(graphModel);
 
-    QJsonArray const &connJsonArray = json["connections"].toArray();
+        for (QJsonValue node : nodesJsonArray) {
+            graphModel.loadNode(node.toObject());
+        }
 
-    for (QJsonValue connection : connJsonArray) {
-        QJsonObject connJson = connection.toObject();
+        for (QJsonValue connection : connJsonArray) {
+            ConnectionId connId = fromJson(connection.toObject());
 
-        ConnectionId connId = fromJson(connJson);
+            // Restore the connection
+            graphModel.addConnection(connId);
 
-        // Restore the connection
-        graphModel.addConnection(connId);
+            restoredConnections.push_back(connId);
+        }
+    }
+
+    for (QJsonValue node : nodesJsonArray) {
+        auto id = node.toObject()["id"].toInt();
 
-        scene->connectionGraphicsObject(connId)->setSelected(true);
+        if (auto ngo = scene->nodeGraphicsObject(id)) {
+            ngo->setZValue(1.0);
+            ngo->setSelected(true);
+        }
+    }
+
+    for (ConnectionId const &connId : restoredConnections) {
+        if (auto cgo = scene->connectionGraphicsObject(connId))
+            cgo->setSelected(true);
     }
 }
 
 static void deleteSerializedItems(QJsonObject &sceneJson, AbstractGraphModel &graphModel)
 {
+    GraphModelBatch batch(graphModel);
+
     QJsonArray connectionJsonArray = sceneJson["connections"].toArray();
 
     for (QJsonValueRef connection : connectionJsonArray) {
@@ -424,7 +442,7 @@ MoveNodeCommand::MoveNodeCommand(BasicGraphicsScene *scene, QPointF const &diff)
 void MoveNodeCommand::undo()
 {
     for (auto nodeId : _selectedNodes) {
-        auto oldPos = _scene->graphModel().nodeData(nodeId, NodeRole::Position).value<QPointF>();
+        auto oldPos = _scene->graphModel().nodePosition(nodeId);
 
         oldPos -= _diff;
 
@@ -435,7 +453,7 @@ void MoveNodeCommand::undo()
 void MoveNodeCommand::redo()
 {
     for (auto nodeId : _selectedNodes) {
-        auto oldPos = _scene->graphModel().nodeData(nodeId, NodeRole::Position).value<QPointF>();
+        auto oldPos = _scene->graphModel().nodePosition(nodeId);
 
         oldPos += _diff;
 
@@ -0,0 +1,118 @@
+#include "WorkStealingThreadPool.hpp"
+
+#include <algorithm>
+
+namespace QtNodes {
+
+namespace {
+
+/// Identifies the pool and the worker running on the current thread.
+thread_local WorkStealingThreadPool const *currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    _workers.reserve(threadCount);
+
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (std::size_t i = 0; i < _workers.size(); ++i) {
+        _workers[i]->thread = std::thread([this, i]() { run(i); });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+
+    _wakeUp.notify_all();
+
+    for (auto &worker : _workers) {
+        worker->thread.join();
+    }
+}
+
+void WorkStealingThreadPool::submit(Task task)
+{
+    std::size_t const workerIndex = (currentPool == this)
+                                        ? currentWorker
+                                        : _nextWorker++ % _workers.size();
+
+    {
+        Worker &worker = *_workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+
+    {
+        // Taking the lock orders the increment with a worker going to sleep.
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_pending;
+    }
+
+    _wakeUp.notify_one();
+}
+
+void WorkStealingThreadPool::run(std::size_t const workerIndex)
+{
+    currentPool = this;
+    currentWorker = workerIndex;
+
+    Task task;
+
+    for (;;) {
+        if (popTask(workerIndex, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+
+        _wakeUp.wait(lock, [this]() { return _pending > 0 || _stopping; });
+
+        if (_stopping && _pending <= 0)
+            return;
+    }
+}
+
+bool WorkStealingThreadPool::popTask(std::size_t const workerIndex, Task &task)
+{
+    {
+        Worker &own = *_workers[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --_pending;
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < _workers.size(); ++offset) {
+        Worker &victim = *_workers[(workerIndex + offset) % _workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --_pending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace QtNodes
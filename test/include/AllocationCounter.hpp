@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+/// Counts the calls of the global `operator new` made while alive.
+/**
+ * The counting replacement of the operator is defined in
+ * AllocationCounter.cpp and is shared by all the threads, so the counted
+ * code should not run concurrently with other allocating code.
+ */
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+
+    ~AllocationCounter();
+
+    AllocationCounter(AllocationCounter const &) = delete;
+
+    AllocationCounter &operator=(AllocationCounter const &) = delete;
+
+    std::size_t count() const;
+
+private:
+    std::size_t _start;
+};
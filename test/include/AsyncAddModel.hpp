@@ -0,0 +1,51 @@
+#pragma once
+
+#include "StubDelegateModels.hpp"
+
+#include <QtCore/QThread>
+
+#include <atomic>
+#include <memory>
+
+/// Add node computing through `computeTask`, off the GUI thread.
+class AsyncAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("AsyncAdd"); }
+
+    QString name() const override { return Name(); }
+
+    ComputeTask computeTask(PortDataList const &inputs) override
+    {
+        for (auto const &input : inputs) {
+            _inputs[input.first] = std::dynamic_pointer_cast<NumberData>(input.second);
+        }
+
+        std::shared_ptr<NumberData> lhs = _inputs[0];
+        std::shared_ptr<NumberData> rhs = _inputs[1];
+
+        return [this, lhs, rhs](QtNodes::CancellationToken const &token) {
+            // Stays busy until released or superseded by newer inputs.
+            while (hold && !token.isCancelled()) {
+                QThread::msleep(1);
+            }
+
+            computeThread = QThread::currentThread();
+
+            if (token.isCancelled()) {
+                ++cancelledCount;
+                return PortDataList();
+            }
+
+            ++computeCount;
+
+            return PortDataList{{0, sum(lhs, rhs)}};
+        };
+    }
+
+public:
+    /// Keeps the computations running until cleared.
+    std::atomic<bool> hold{false};
+
+    std::atomic<int> cancelledCount{0};
+};
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <QtNodes/NodeData>
+#include <QtNodes/NodeDelegateModel>
+
+#include <QtCore/QString>
+#include <QtCore/QThread>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/// Number travelling between the stub nodes.
+class NumberData : public QtNodes::NodeData
+{
+public:
+    explicit NumberData(double const number = 0.0)
+        : _number(number)
+    {}
+
+    QtNodes::NodeDataType type() const override
+    {
+        return {QStringLiteral("number"), QStringLiteral("Number")};
+    }
+
+    double number() const { return _number; }
+
+    std::uint64_t fingerprint() const override
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &_number, sizeof(bits));
+
+        return bits ^ 0x6e756d626572ull;
+    }
+
+    bool equals(QtNodes::NodeData const &other) const override
+    {
+        auto data = dynamic_cast<NumberData const *>(&other);
+
+        return data && data->_number == _number;
+    }
+
+    bool scalarValue(double &value) const override
+    {
+        value = _number;
+        return true;
+    }
+
+private:
+    double _number;
+};
+
+inline double numberOf(std::shared_ptr<QtNodes::NodeData> const &data)
+{
+    auto number = std::dynamic_pointer_cast<NumberData>(data);
+
+    return number ? number->number() : -1.0;
+}
+
+/// Emits the number it is set to.
+class SourceModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return QStringLiteral("Source"); }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType const portType) const override
+    {
+        return portType == QtNodes::PortType::Out ? 1 : 0;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return NumberData().type();
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData>, QtNodes::PortIndex const) override {}
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return _number;
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    void setNumber(double const number)
+    {
+        _number = std::make_shared<NumberData>(number);
+
+        Q_EMIT dataUpdated(0);
+    }
+
+    void invalidate()
+    {
+        _number.reset();
+
+        Q_EMIT dataInvalidated(0);
+    }
+
+private:
+    std::shared_ptr<NumberData> _number;
+};
+
+/**
+ * Adds its two inputs and counts the computations.
+ *
+ * Computes synchronously on the GUI thread, the tests of the other
+ * execution features derive their delegates from this one.
+ */
+class AddModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return QStringLiteral("Add"); }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType const portType) const override
+    {
+        return portType == QtNodes::PortType::In ? 2 : 1;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return NumberData().type();
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData> nodeData,
+                   QtNodes::PortIndex const portIndex) override
+    {
+        _inputs[portIndex] = std::dynamic_pointer_cast<NumberData>(nodeData);
+
+        compute();
+    }
+
+    void setChangedInData(PortDataList const &inputs) override
+    {
+        for (auto const &input : inputs) {
+            _inputs[input.first] = std::dynamic_pointer_cast<NumberData>(input.second);
+        }
+
+        compute();
+    }
+
+    void setComputeResult(PortDataList const &outputs) override
+    {
+        ++resultCount;
+
+        _result = outputs.empty() ? nullptr : outputs.front().second;
+    }
+
+    void inputsInvalidated() override
+    {
+        ++invalidationCount;
+
+        _result.reset();
+    }
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return _result;
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+public:
+    std::atomic<int> computeCount{0};
+
+    /// Thread of the latest computation.
+    std::atomic<QThread *> computeThread{nullptr};
+
+    int resultCount = 0;
+
+    int invalidationCount = 0;
+
+protected:
+    static std::shared_ptr<QtNodes::NodeData> sum(std::shared_ptr<NumberData> const &lhs,
+                                                  std::shared_ptr<NumberData> const &rhs)
+    {
+        if (!lhs || !rhs)
+            return nullptr;
+
+        return std::make_shared<NumberData>(lhs->number() + rhs->number());
+    }
+
+    void compute()
+    {
+        ++computeCount;
+
+        computeThread = QThread::currentThread();
+
+        _result = sum(_inputs[0], _inputs[1]);
+
+        Q_EMIT dataUpdated(0);
+    }
+
+protected:
+    std::shared_ptr<NumberData> _inputs[2];
+
+    std::shared_ptr<QtNodes::NodeData> _result;
+};
+
+/// Records every data delivered to its only input.
+class SinkModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return QStringLiteral("Sink"); }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType const portType) const override
+    {
+        return portType == QtNodes::PortType::In ? 1 : 0;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return NumberData().type();
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData> nodeData, QtNodes::PortIndex const) override
+    {
+        received.push_back(std::move(nodeData));
+    }
+
+    void inputsInvalidated() override { ++invalidationCount; }
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return nullptr;
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    /// The latest number, -1 when the latest data is empty.
+    double number() const { return received.empty() ? -1.0 : numberOf(received.back()); }
+
+    /// All the numbers received so far, the empty data left out.
+    std::vector<double> numbers() const
+    {
+        std::vector<double> result;
+
+        for (auto const &data : received) {
+            if (data)
+                result.push_back(numberOf(data));
+        }
+
+        return result;
+    }
+
+public:
+    std::vector<std::shared_ptr<QtNodes::NodeData>> received;
+
+    int invalidationCount = 0;
+};
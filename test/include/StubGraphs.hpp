@@ -0,0 +1,54 @@
+#pragma once
+
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include <memory>
+
+/// Registry with the basic stub delegates and the given `Models`.
+template<typename... Models>
+std::shared_ptr<QtNodes::NodeDelegateModelRegistry> stubRegistry()
+{
+    auto registry = std::make_shared<QtNodes::NodeDelegateModelRegistry>();
+
+    registry->registerModel<SourceModel>();
+    registry->registerModel<AddModel>();
+    registry->registerModel<SinkModel>();
+
+    int const registered[] = {0, (registry->registerModel<Models>(), 0)...};
+    (void) registered;
+
+    return registry;
+}
+
+/// Source feeding both operands of an `Add` node, which feeds Sink.
+template<typename Add>
+struct BasicDiamond
+{
+    explicit BasicDiamond(QtNodes::DataFlowGraphModel &model)
+        : model(model)
+        , source(model.addNode(SourceModel::Name()))
+        , add(model.addNode(Add::Name()))
+        , sink(model.addNode(SinkModel::Name()))
+    {
+        model.addConnection(QtNodes::ConnectionId{source, 0, add, 0});
+        model.addConnection(QtNodes::ConnectionId{source, 0, add, 1});
+        model.addConnection(QtNodes::ConnectionId{add, 0, sink, 0});
+    }
+
+    SourceModel *sourceModel() const { return model.delegateModel<SourceModel>(source); }
+
+    Add *addModel() const { return model.delegateModel<Add>(add); }
+
+    SinkModel *sinkModel() const { return model.delegateModel<SinkModel>(sink); }
+
+    QtNodes::DataFlowGraphModel &model;
+
+    QtNodes::NodeId const source;
+    QtNodes::NodeId const add;
+    QtNodes::NodeId const sink;
+};
+
+using Diamond = BasicDiamond<AddModel>;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+
+/// Runs the event loop until `done` returns true, @returns false on timeout.
+template<typename Predicate>
+bool waitUntil(Predicate done, int const timeoutMsec = 5000)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!done()) {
+        if (timer.elapsed() > timeoutMsec)
+            return false;
+
+        QCoreApplication::processEvents();
+        QThread::msleep(1);
+    }
+
+    return true;
+}
@@ -0,0 +1,50 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<int> activeCounters{0};
+
+std::atomic<std::size_t> allocations{0};
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    if (activeCounters.load(std::memory_order_relaxed) > 0)
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+AllocationCounter::AllocationCounter()
+    : _start(allocations.load())
+{
+    ++activeCounters;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    --activeCounters;
+}
+
+std::size_t AllocationCounter::count() const
+{
+    return allocations.load() - _start;
+}
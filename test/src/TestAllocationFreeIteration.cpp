@@ -0,0 +1,75 @@
+#include "AllocationCounter.hpp"
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+using QtNodes::PortCount;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+TEST_CASE("Visiting the graph does not allocate", "[performance]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+
+    Diamond diamond(model);
+
+    NodeId const other = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{diamond.add, 0, other, 0});
+
+    std::size_t nodes = 0;
+    std::size_t nodeConnections = 0;
+    std::size_t portConnections = 0;
+    std::size_t counted = 0;
+
+    AllocationCounter counter;
+
+    model.forEachNode([&](NodeId const nodeId) {
+        ++nodes;
+
+        model.forEachConnection(nodeId, [&](ConnectionId const &) { ++nodeConnections; });
+
+        for (PortType portType : {PortType::Out, PortType::In}) {
+            PortCount const n = model.portCount(nodeId, portType);
+
+            for (PortIndex portIndex = 0; portIndex < n; ++portIndex) {
+                counted += model.connectionCount(nodeId, portType, portIndex);
+
+                model.forEachConnection(nodeId,
+                                        portType,
+                                        portIndex,
+                                        [&](ConnectionId const &) { ++portConnections; });
+            }
+        }
+    });
+
+    CHECK(counter.count() == 0);
+
+    // Every connection is seen from both of its ends.
+    CHECK(nodes == 4);
+    CHECK(nodeConnections == 8);
+    CHECK(portConnections == 8);
+    CHECK(counted == 8);
+}
+
+TEST_CASE("The set-returning queries allocate, unlike the visitors", "[performance]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+
+    Diamond diamond(model);
+
+    AllocationCounter counter;
+
+    CHECK(model.allConnectionIds(diamond.add).size() == 3);
+    CHECK(counter.count() > 0);
+}
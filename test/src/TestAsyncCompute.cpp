@@ -0,0 +1,107 @@
+#include "ApplicationSetup.hpp"
+#include "AsyncAddModel.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Newer inputs cancel a running computation", "[async]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<AsyncAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    BasicDiamond<AsyncAddModel> diamond(model);
+
+    // The new connections hand the empty source output to the node.
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    AsyncAddModel *add = diamond.addModel();
+    add->hold = true;
+
+    diamond.sourceModel()->setNumber(1.0);
+
+    REQUIRE(model.isComputing(diamond.add));
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    // The superseded computation returns once it notices the cancellation.
+    REQUIRE(waitUntil([&]() { return add->cancelledCount == 1; }));
+
+    add->hold = false;
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    CHECK(add->resultCount == 1);
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{4.0});
+}
+
+TEST_CASE("Connections made during a computation receive its result", "[async]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<AsyncAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    NodeId const lhs = model.addNode(SourceModel::Name());
+    NodeId const rhs = model.addNode(SourceModel::Name());
+    NodeId const add = model.addNode(AsyncAddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{lhs, 0, add, 0});
+    model.addConnection(ConnectionId{rhs, 0, add, 1});
+    model.addConnection(ConnectionId{add, 0, sink, 0});
+
+    SourceModel *lhsModel = model.delegateModel<SourceModel>(lhs);
+    SourceModel *rhsModel = model.delegateModel<SourceModel>(rhs);
+    AsyncAddModel *addModel = model.delegateModel<AsyncAddModel>(add);
+
+    lhsModel->setNumber(1.0);
+    rhsModel->setNumber(3.0);
+
+    REQUIRE(waitUntil([&]() { return model.delegateModel<SinkModel>(sink)->number() == 4.0; }));
+
+    addModel->hold = true;
+
+    NodeId const late = model.addNode(SinkModel::Name());
+
+    SECTION("an equal result")
+    {
+        // Both operands change at once, the sum stays the same.
+        model.setCoalescingInterval(60000);
+
+        lhsModel->setNumber(3.0);
+        rhsModel->setNumber(1.0);
+
+        model.flushCoalescedUpdates();
+    }
+
+    SECTION("a cancelled computation")
+    {
+        lhsModel->setNumber(3.0);
+    }
+
+    REQUIRE(model.isComputing(add));
+
+    model.addConnection(ConnectionId{add, 0, late, 0});
+
+    CHECK(model.delegateModel<SinkModel>(late)->received.empty());
+
+    // Supersedes the running computation in the second section.
+    rhsModel->setNumber(1.0);
+
+    addModel->hold = false;
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(add); }));
+
+    CHECK(model.delegateModel<SinkModel>(late)->number() == 4.0);
+}
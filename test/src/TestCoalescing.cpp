@@ -0,0 +1,53 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using QtNodes::DataFlowGraphModel;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Coalescing delivers only the latest source update", "[coalescing]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    Diamond diamond(model);
+
+    int const computeCount = diamond.addModel()->computeCount;
+    std::size_t const received = diamond.sinkModel()->received.size();
+
+    SECTION("flushed explicitly")
+    {
+        model.setCoalescingInterval(60000);
+
+        for (double number : {1.0, 2.0, 3.0}) {
+            diamond.sourceModel()->setNumber(number);
+        }
+
+        CHECK(diamond.addModel()->computeCount == computeCount);
+        CHECK(diamond.sinkModel()->received.size() == received);
+
+        model.flushCoalescedUpdates();
+
+        CHECK(diamond.addModel()->computeCount - computeCount == 1);
+        CHECK(diamond.sinkModel()->numbers() == std::vector<double>{6.0});
+    }
+
+    SECTION("flushed by the timer")
+    {
+        model.setCoalescingInterval(0);
+
+        diamond.sourceModel()->setNumber(1.0);
+        diamond.sourceModel()->setNumber(5.0);
+
+        REQUIRE(waitUntil([&]() { return diamond.sinkModel()->number() == 10.0; }));
+
+        CHECK(diamond.addModel()->computeCount - computeCount == 1);
+    }
+}
@@ -0,0 +1,154 @@
+#include "ColumnKernels.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+using ColumnKernels::Operand;
+
+namespace {
+
+using Kernel = std::function<void(Operand const &, Operand const &, double *, std::size_t)>;
+
+using Reference = std::function<double(double, double)>;
+
+/// Sizes below, at and past the vector width leave every length of tail.
+std::vector<std::size_t> const sizes = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 17};
+
+/// Values counted from `first`, none of them zero.
+std::vector<double> values(std::size_t const size, double const first)
+{
+    std::vector<double> result;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        result.push_back(first + 0.25 * static_cast<double>(i));
+    }
+
+    return result;
+}
+
+/// Runs the kernel on copies starting at `offset` elements, an offset of
+/// one puts the columns off the vector alignment.
+void checkAgainstScalar(Kernel const &kernel, Reference const &reference)
+{
+    for (std::size_t const offset : {0, 1}) {
+        for (std::size_t const size : sizes) {
+            std::vector<double> const a = values(size, -3.5);
+            std::vector<double> const b = values(size, 1.5);
+
+            std::vector<double> lhs(offset, 0.0);
+            std::vector<double> rhs(offset, 0.0);
+            lhs.insert(lhs.end(), a.begin(), a.end());
+            rhs.insert(rhs.end(), b.begin(), b.end());
+
+            std::vector<double> result(offset + size, 0.0);
+
+            CAPTURE(offset, size);
+
+            kernel(Operand(lhs.data() + offset), Operand(rhs.data() + offset),
+                   result.data() + offset, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                CHECK(result[offset + i] == reference(a[i], b[i]));
+            }
+
+            kernel(Operand(lhs.data() + offset), Operand(2.0), result.data() + offset, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                CHECK(result[offset + i] == reference(a[i], 2.0));
+            }
+
+            kernel(Operand(2.0), Operand(rhs.data() + offset), result.data() + offset, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                CHECK(result[offset + i] == reference(2.0, b[i]));
+            }
+
+            kernel(Operand(2.0), Operand(0.5), result.data() + offset, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                CHECK(result[offset + i] == reference(2.0, 0.5));
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Column kernels match the scalar operations", "[kernels]")
+{
+    SECTION("addition")
+    {
+        checkAgainstScalar(ColumnKernels::add, [](double a, double b) { return a + b; });
+    }
+
+    SECTION("subtraction")
+    {
+        checkAgainstScalar(ColumnKernels::subtract, [](double a, double b) { return a - b; });
+    }
+
+    SECTION("multiplication")
+    {
+        checkAgainstScalar(ColumnKernels::multiply, [](double a, double b) { return a * b; });
+    }
+
+    SECTION("division")
+    {
+        auto divide = [](Operand const &lhs, Operand const &rhs, double *result, std::size_t size) {
+            REQUIRE(ColumnKernels::divide(lhs, rhs, result, size));
+        };
+
+        checkAgainstScalar(divide, [](double a, double b) { return a / b; });
+    }
+}
+
+TEST_CASE("Column division rejects zero divisors", "[kernels]")
+{
+    std::size_t const size = 7;
+
+    std::vector<double> const dividend = values(size, 1.0);
+    std::vector<double> divisor = values(size, 1.0);
+    std::vector<double> result(size, 42.0);
+
+    SECTION("in the vector part")
+    {
+        divisor[1] = 0.0;
+
+        CHECK_FALSE(ColumnKernels::divide(Operand(dividend.data()),
+                                          Operand(divisor.data()),
+                                          result.data(),
+                                          size));
+    }
+
+    SECTION("in the tail")
+    {
+        divisor[size - 1] = -0.0;
+
+        CHECK_FALSE(ColumnKernels::divide(Operand(dividend.data()),
+                                          Operand(divisor.data()),
+                                          result.data(),
+                                          size));
+    }
+
+    SECTION("as a single number")
+    {
+        CHECK_FALSE(
+            ColumnKernels::divide(Operand(dividend.data()), Operand(0.0), result.data(), size));
+    }
+
+    // Like the single numbers, there is no quotient at all.
+    CHECK(result == std::vector<double>(size, 42.0));
+
+    SECTION("a zero dividend is not rejected")
+    {
+        std::vector<double> zeros(size, 0.0);
+
+        CHECK(ColumnKernels::divide(Operand(zeros.data()),
+                                    Operand(divisor.data()),
+                                    result.data(),
+                                    size));
+        CHECK(result == zeros);
+    }
+}
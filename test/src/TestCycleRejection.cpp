@@ -0,0 +1,69 @@
+#include "ApplicationSetup.hpp"
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/ConnectionIdUtils>
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+
+TEST_CASE("Connections closing a cycle are rejected", "[topology]")
+{
+    auto setup = applicationSetup();
+
+    auto registry = std::make_shared<NodeDelegateModelRegistry>();
+    registry->registerModel<AddModel>();
+
+    DataFlowGraphModel model(registry);
+
+    NodeId const first = model.addNode(AddModel::Name());
+    NodeId const second = model.addNode(AddModel::Name());
+
+    std::vector<ConnectionId> rejected;
+
+    QObject::connect(&model,
+                     &DataFlowGraphModel::connectionRejected,
+                     [&](ConnectionId const connectionId) { rejected.push_back(connectionId); });
+
+    ConnectionId const forward{first, 0, second, 0};
+    ConnectionId const backward{second, 0, first, 0};
+
+    model.addConnection(forward);
+
+    SECTION("addConnection reports the rejection")
+    {
+        CHECK_FALSE(model.connectionPossible(backward));
+
+        model.addConnection(backward);
+
+        CHECK_FALSE(model.connectionExists(backward));
+        REQUIRE(rejected.size() == 1);
+        CHECK(rejected.front() == backward);
+    }
+
+    SECTION("load refuses a file with a cycle")
+    {
+        QJsonObject scene = model.save();
+
+        QJsonArray connections = scene["connections"].toArray();
+        connections.append(QtNodes::toJson(backward));
+        scene["connections"] = connections;
+
+        DataFlowGraphModel loaded(registry);
+
+        CHECK_THROWS_AS(loaded.load(scene), std::logic_error);
+        CHECK_FALSE(loaded.connectionExists(backward));
+    }
+}
@@ -0,0 +1,60 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QThread>
+
+#include <vector>
+
+using QtNodes::DataFlowGraphModel;
+
+using ExecutionAffinity = QtNodes::NodeDelegateModel::ExecutionAffinity;
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+namespace {
+
+/// Add node standing for a blocking I/O operation.
+class IoAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("IoAdd"); }
+
+    QString name() const override { return Name(); }
+
+    ExecutionAffinity affinity() const override { return ExecutionAffinity::IoThread; }
+};
+
+} // namespace
+
+TEST_CASE("I/O nodes compute on their own thread", "[affinity]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<IoAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    BasicDiamond<IoAddModel> diamond(model);
+
+    // The new connections hand the empty source output to the node.
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    CHECK(model.isComputing(diamond.add));
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    QThread *const ioThread = diamond.addModel()->computeThread;
+
+    CHECK(ioThread != QThread::currentThread());
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{4.0});
+
+    diamond.sourceModel()->setNumber(3.0);
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    CHECK(diamond.addModel()->computeThread == ioThread);
+    CHECK(diamond.sinkModel()->number() == 6.0);
+}
@@ -0,0 +1,118 @@
+#include "ApplicationSetup.hpp"
+#include "AsyncAddModel.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::ExecutionPlan;
+using QtNodes::NodeId;
+
+TEST_CASE("A compiled plan evaluates the graph headlessly", "[plan]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+
+    // (source + source) + source -> sink
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const inner = model.addNode(AddModel::Name());
+    NodeId const outer = model.addNode(AddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{source, 0, inner, 0});
+    model.addConnection(ConnectionId{source, 0, inner, 1});
+    model.addConnection(ConnectionId{inner, 0, outer, 0});
+    model.addConnection(ConnectionId{source, 0, outer, 1});
+    model.addConnection(ConnectionId{outer, 0, sink, 0});
+
+    AddModel *innerModel = model.delegateModel<AddModel>(inner);
+    AddModel *outerModel = model.delegateModel<AddModel>(outer);
+
+    int const innerCount = innerModel->computeCount;
+    int const outerCount = outerModel->computeCount;
+
+    ExecutionPlan::Slots slots;
+
+    SECTION("every node runs its delegate")
+    {
+        ExecutionPlan const plan = model.compile();
+
+        ExecutionPlan::Inputs const inputs{
+            {plan.outputSlot(source, 0), std::make_shared<NumberData>(3.0)}};
+
+        REQUIRE(model.execute(plan, inputs, slots));
+
+        CHECK(numberOf(slots[plan.outputSlot(inner, 0)]) == 6.0);
+        CHECK(numberOf(slots[plan.outputSlot(outer, 0)]) == 9.0);
+        CHECK(innerModel->computeCount - innerCount == 1);
+        CHECK(outerModel->computeCount - outerCount == 1);
+        CHECK(model.delegateModel<SinkModel>(sink)->number() == 9.0);
+    }
+
+    SECTION("a plan refuses to run on a changed graph")
+    {
+        ExecutionPlan const plan = model.compile();
+
+        model.addNode(SinkModel::Name());
+
+        CHECK_FALSE(model.execute(plan, {}, slots));
+    }
+
+    SECTION("the propagation continues from the evaluated data")
+    {
+        model.delegateModel<SourceModel>(source)->setNumber(1.0);
+
+        REQUIRE(model.delegateModel<SinkModel>(sink)->number() == 3.0);
+
+        ExecutionPlan const plan = model.compile();
+
+        ExecutionPlan::Inputs const inputs{
+            {plan.outputSlot(source, 0), std::make_shared<NumberData>(3.0)}};
+
+        REQUIRE(model.execute(plan, inputs, slots));
+        REQUIRE(model.delegateModel<SinkModel>(sink)->number() == 9.0);
+
+        // The source output differs from the evaluated one, not from the
+        // one propagated before.
+        model.delegateModel<SourceModel>(source)->setNumber(1.0);
+
+        CHECK(model.delegateModel<SinkModel>(sink)->number() == 3.0);
+    }
+}
+
+TEST_CASE("A plan refuses to run during a computation", "[plan]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<AsyncAddModel>());
+
+    BasicDiamond<AsyncAddModel> diamond(model);
+
+    // The new connections hand the empty source output to the node.
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    ExecutionPlan const plan = model.compile();
+
+    AsyncAddModel *add = diamond.addModel();
+    add->hold = true;
+
+    diamond.sourceModel()->setNumber(1.0);
+
+    REQUIRE(model.isComputing(diamond.add));
+
+    ExecutionPlan::Slots slots;
+
+    CHECK_FALSE(model.execute(plan, {}, slots));
+
+    add->hold = false;
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    CHECK(model.execute(plan, {}, slots));
+    CHECK(numberOf(slots[plan.outputSlot(diamond.add, 0)]) == 2.0);
+}
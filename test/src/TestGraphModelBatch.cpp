@@ -0,0 +1,72 @@
+#include "ApplicationSetup.hpp"
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+using QtNodes::AbstractGraphModel;
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::GraphModelBatch;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+
+TEST_CASE("A batch reports only the items surviving it", "[batch]")
+{
+    auto setup = applicationSetup();
+
+    auto registry = std::make_shared<NodeDelegateModelRegistry>();
+    registry->registerModel<SourceModel>();
+    registry->registerModel<SinkModel>();
+
+    DataFlowGraphModel model(registry);
+
+    NodeId const existing = model.addNode(SourceModel::Name());
+
+    std::vector<NodeId> created;
+    std::vector<NodeId> deleted;
+    std::vector<ConnectionId> createdConnections;
+
+    QObject::connect(&model,
+                     &AbstractGraphModel::nodesCreated,
+                     [&](std::vector<NodeId> const &ids) { created = ids; });
+    QObject::connect(&model,
+                     &AbstractGraphModel::nodesDeleted,
+                     [&](std::vector<NodeId> const &ids) { deleted = ids; });
+    QObject::connect(&model,
+                     &AbstractGraphModel::connectionsCreated,
+                     [&](std::vector<ConnectionId> const &ids) { createdConnections = ids; });
+
+    std::vector<NodeId> sinks;
+
+    {
+        GraphModelBatch batch(model);
+
+        for (int i = 0; i < 100; ++i) {
+            sinks.push_back(model.addNode(SinkModel::Name()));
+            model.addConnection(ConnectionId{existing, 0, sinks.back(), 0});
+        }
+
+        // Every other sink goes away again, together with its connection.
+        for (std::size_t i = 0; i < sinks.size(); i += 2) {
+            model.deleteNode(sinks[i]);
+        }
+
+        model.deleteNode(existing);
+    }
+
+    REQUIRE(created.size() == 50);
+
+    for (std::size_t i = 0; i < created.size(); ++i) {
+        CHECK(created[i] == sinks[2 * i + 1]);
+    }
+
+    // The connections of the surviving sinks were deleted with the source.
+    CHECK(createdConnections.empty());
+    CHECK(deleted == std::vector<NodeId>{existing});
+}
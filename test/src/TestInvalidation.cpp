@@ -0,0 +1,166 @@
+#include "ApplicationSetup.hpp"
+#include "AsyncAddModel.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+namespace {
+
+/// Add node relying on the default handling of the invalidations.
+class DefaultInvalidationAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("DefaultInvalidationAdd"); }
+
+    QString name() const override { return Name(); }
+
+    void inputsInvalidated() override { QtNodes::NodeDelegateModel::inputsInvalidated(); }
+};
+
+} // namespace
+
+TEST_CASE("An invalidation marks the whole downstream cone", "[invalidation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    Diamond diamond(model);
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    int const computeCount = diamond.addModel()->computeCount;
+
+    diamond.sourceModel()->invalidate();
+
+    CHECK(model.nodeInvalidated(diamond.add));
+    CHECK(model.nodeInvalidated(diamond.sink));
+    CHECK(diamond.addModel()->invalidationCount == 1);
+    CHECK(diamond.sinkModel()->invalidationCount == 1);
+
+    // The delegates were told instead of computing with empty data.
+    CHECK(diamond.addModel()->computeCount == computeCount);
+    CHECK(diamond.sinkModel()->number() == 4.0);
+
+    diamond.sourceModel()->setNumber(3.0);
+
+    CHECK_FALSE(model.nodeInvalidated(diamond.add));
+    CHECK_FALSE(model.nodeInvalidated(diamond.sink));
+    CHECK(diamond.sinkModel()->number() == 6.0);
+}
+
+TEST_CASE("Data equal to the one before an invalidation is delivered again", "[invalidation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    // (lhs + rhs) + zero -> sink
+    NodeId const lhs = model.addNode(SourceModel::Name());
+    NodeId const rhs = model.addNode(SourceModel::Name());
+    NodeId const zero = model.addNode(SourceModel::Name());
+    NodeId const inner = model.addNode(AddModel::Name());
+    NodeId const outer = model.addNode(AddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{lhs, 0, inner, 0});
+    model.addConnection(ConnectionId{rhs, 0, inner, 1});
+    model.addConnection(ConnectionId{inner, 0, outer, 0});
+    model.addConnection(ConnectionId{zero, 0, outer, 1});
+    model.addConnection(ConnectionId{outer, 0, sink, 0});
+
+    model.delegateModel<SourceModel>(zero)->setNumber(0.0);
+    model.delegateModel<SourceModel>(lhs)->setNumber(1.0);
+    model.delegateModel<SourceModel>(rhs)->setNumber(2.0);
+
+    REQUIRE(model.delegateModel<SinkModel>(sink)->number() == 3.0);
+
+    model.delegateModel<SourceModel>(rhs)->invalidate();
+
+    REQUIRE(model.nodeInvalidated(sink));
+
+    // Every output on the way repeats the one from before.
+    model.delegateModel<SourceModel>(rhs)->setNumber(2.0);
+
+    CHECK_FALSE(model.nodeInvalidated(outer));
+    CHECK_FALSE(model.nodeInvalidated(sink));
+    CHECK(model.delegateModel<SinkModel>(sink)->number() == 3.0);
+}
+
+TEST_CASE("An invalidation cancels the running computation", "[invalidation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<AsyncAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    BasicDiamond<AsyncAddModel> diamond(model);
+
+    // The new connections hand the empty source output to the node.
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    AsyncAddModel *add = diamond.addModel();
+    add->hold = true;
+
+    diamond.sourceModel()->setNumber(1.0);
+
+    REQUIRE(model.isComputing(diamond.add));
+
+    diamond.sourceModel()->invalidate();
+
+    // The delegate belongs to the worker until the computation returns.
+    CHECK(add->invalidationCount == 0);
+    CHECK(model.nodeInvalidated(diamond.sink));
+
+    REQUIRE(waitUntil([&]() { return add->cancelledCount == 1; }));
+
+    add->hold = false;
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    CHECK(add->invalidationCount == 1);
+    CHECK(add->resultCount == 0);
+    CHECK(model.nodeInvalidated(diamond.sink));
+    CHECK(diamond.sinkModel()->numbers().empty());
+}
+
+TEST_CASE("The default invalidation empties the inputs silently", "[invalidation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<DefaultInvalidationAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    BasicDiamond<DefaultInvalidationAddModel> diamond(model);
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    REQUIRE(diamond.sinkModel()->number() == 4.0);
+
+    int const computeCount = diamond.addModel()->computeCount;
+    std::size_t const received = diamond.sinkModel()->received.size();
+
+    diamond.sourceModel()->invalidate();
+
+    // Once per input port, the emitted updates are not propagated.
+    CHECK(diamond.addModel()->computeCount - computeCount == 2);
+    CHECK(diamond.addModel()->outData(0) == nullptr);
+    CHECK(diamond.sinkModel()->received.size() == received);
+    CHECK(model.nodeInvalidated(diamond.sink));
+
+    diamond.sourceModel()->setNumber(3.0);
+
+    CHECK_FALSE(model.nodeInvalidated(diamond.sink));
+    CHECK(diamond.sinkModel()->number() == 6.0);
+}
@@ -0,0 +1,125 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::ExecutionPlan;
+using QtNodes::NodeId;
+
+namespace {
+
+class FusableAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("FusableAdd"); }
+
+    QString name() const override { return Name(); }
+
+    QtNodes::FusableExpression fusableExpression() const override
+    {
+        return {QtNodes::FusableExpression::Operation::Add,
+                [](double const value) { return std::make_shared<NumberData>(value); }};
+    }
+
+    /// Emits, which the graph model must not take for a new output.
+    void setComputeResult(PortDataList const &outputs) override
+    {
+        AddModel::setComputeResult(outputs);
+
+        Q_EMIT dataUpdated(0);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Fused nodes run as one kernel", "[fusion]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<FusableAddModel>());
+
+    // (source + source) + source -> sink
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const inner = model.addNode(FusableAddModel::Name());
+    NodeId const outer = model.addNode(FusableAddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{source, 0, inner, 0});
+    model.addConnection(ConnectionId{source, 0, inner, 1});
+    model.addConnection(ConnectionId{inner, 0, outer, 0});
+    model.addConnection(ConnectionId{source, 0, outer, 1});
+    model.addConnection(ConnectionId{outer, 0, sink, 0});
+
+    FusableAddModel *innerModel = model.delegateModel<FusableAddModel>(inner);
+    FusableAddModel *outerModel = model.delegateModel<FusableAddModel>(outer);
+    SinkModel *sinkModel = model.delegateModel<SinkModel>(sink);
+
+    int const innerCount = innerModel->computeCount;
+    int const outerCount = outerModel->computeCount;
+
+    ExecutionPlan const plan = model.compile(true);
+
+    REQUIRE(plan.kernels().size() == 1);
+
+    std::size_t const received = sinkModel->received.size();
+
+    ExecutionPlan::Inputs const inputs{
+        {plan.outputSlot(source, 0), std::make_shared<NumberData>(3.0)}};
+
+    ExecutionPlan::Slots slots;
+
+    REQUIRE(model.execute(plan, inputs, slots));
+
+    CHECK(slots[plan.outputSlot(inner, 0)] == nullptr);
+    CHECK(numberOf(slots[plan.outputSlot(outer, 0)]) == 9.0);
+    CHECK(innerModel->computeCount == innerCount);
+    CHECK(outerModel->computeCount == outerCount);
+    CHECK(outerModel->resultCount == 1);
+    CHECK(sinkModel->number() == 9.0);
+
+    // Only the plan delivered to the sink.
+    CHECK(sinkModel->received.size() - received == 1);
+}
+
+TEST_CASE("A long chain fuses into one kernel", "[fusion]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<FusableAddModel>());
+
+    // More registers than a 16-bit index holds, emitted without recursion.
+    std::size_t const length = std::numeric_limits<std::uint16_t>::max() / 2 + 1;
+
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId previous = source;
+
+    for (std::size_t i = 0; i < length; ++i) {
+        NodeId const add = model.addNode(FusableAddModel::Name());
+
+        model.addConnection(ConnectionId{previous, 0, add, 0});
+        model.addConnection(ConnectionId{source, 0, add, 1});
+
+        previous = add;
+    }
+
+    ExecutionPlan const plan = model.compile(true);
+
+    REQUIRE(plan.kernels().size() == 1);
+    CHECK(plan.kernels().front().fusedSteps.size() == length - 1);
+    CHECK(plan.registerCount() > std::numeric_limits<std::uint16_t>::max());
+
+    ExecutionPlan::Inputs const inputs{
+        {plan.outputSlot(source, 0), std::make_shared<NumberData>(1.0)}};
+
+    ExecutionPlan::Slots slots;
+
+    REQUIRE(model.execute(plan, inputs, slots));
+
+    CHECK(numberOf(slots[plan.outputSlot(previous, 0)]) == static_cast<double>(length + 1));
+}
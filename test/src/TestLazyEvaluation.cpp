@@ -0,0 +1,99 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Lazy propagation skips the unobserved branches", "[lazy]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Lazy);
+
+    Diamond diamond(model);
+
+    // A second branch nobody looks at.
+    NodeId const idle = model.addNode(AddModel::Name());
+
+    model.addConnection(ConnectionId{diamond.source, 0, idle, 0});
+    model.addConnection(ConnectionId{diamond.source, 0, idle, 1});
+
+    AddModel *idleModel = model.delegateModel<AddModel>(idle);
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    CHECK(diamond.sinkModel()->number() == 4.0);
+    CHECK(idleModel->computeCount == 0);
+
+    SECTION("evaluate brings the branch up to date at once")
+    {
+        model.evaluate(idle);
+
+        CHECK(idleModel->computeCount == 1);
+        CHECK(numberOf(idleModel->outData(0)) == 4.0);
+    }
+
+    SECTION("observing the node evaluates it and keeps it up to date")
+    {
+        model.setNodeObserved(idle, true);
+
+        CHECK(idleModel->computeCount == 1);
+
+        diamond.sourceModel()->setNumber(3.0);
+
+        CHECK(idleModel->computeCount == 2);
+        CHECK(numberOf(idleModel->outData(0)) == 6.0);
+    }
+}
+
+TEST_CASE("Lazy propagation follows the changes of the demand", "[lazy]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Lazy);
+
+    Diamond diamond(model);
+
+    NodeId const idle = model.addNode(AddModel::Name());
+
+    model.addConnection(ConnectionId{diamond.source, 0, idle, 0});
+    model.addConnection(ConnectionId{diamond.source, 0, idle, 1});
+
+    AddModel *idleModel = model.delegateModel<AddModel>(idle);
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    REQUIRE(idleModel->computeCount == 0);
+
+    SECTION("a new sink downstream demands the branch")
+    {
+        NodeId const sink = model.addNode(SinkModel::Name());
+
+        model.addConnection(ConnectionId{idle, 0, sink, 0});
+
+        diamond.sourceModel()->setNumber(3.0);
+
+        CHECK(numberOf(idleModel->outData(0)) == 6.0);
+        CHECK(model.delegateModel<SinkModel>(sink)->number() == 6.0);
+    }
+
+    SECTION("an unobserved node is skipped again")
+    {
+        model.setNodeObserved(idle, true);
+        model.setNodeObserved(idle, false);
+
+        int const computeCount = idleModel->computeCount;
+
+        diamond.sourceModel()->setNumber(3.0);
+
+        CHECK(idleModel->computeCount == computeCount);
+        CHECK(diamond.sinkModel()->number() == 6.0);
+    }
+}
@@ -0,0 +1,194 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include "OutputCache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+namespace {
+
+class MemoizedAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("MemoizedAdd"); }
+
+    QString name() const override { return Name(); }
+
+    bool memoizable() const override { return true; }
+
+    /// Emits new outputs on its own, like after a parameter change.
+    void recompute() { compute(); }
+};
+
+/// Opts in, but keeps the default `setComputeResult`.
+class ForgetfulAddModel : public MemoizedAddModel
+{
+public:
+    static QString Name() { return QStringLiteral("ForgetfulAdd"); }
+
+    QString name() const override { return Name(); }
+
+    void setComputeResult(PortDataList const &outputs) override
+    {
+        ++resultCount;
+
+        NodeDelegateModel::setComputeResult(outputs);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Memoized nodes reuse the outputs of equal inputs", "[memoization]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<MemoizedAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+    model.setMemoizationBudget(1 << 20);
+
+    NodeId const lhs = model.addNode(SourceModel::Name());
+    NodeId const rhs = model.addNode(SourceModel::Name());
+    NodeId const add = model.addNode(MemoizedAddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    MemoizedAddModel *addModel = model.delegateModel<MemoizedAddModel>(add);
+
+    model.addConnection(ConnectionId{lhs, 0, add, 0});
+    model.addConnection(ConnectionId{rhs, 0, add, 1});
+    model.addConnection(ConnectionId{add, 0, sink, 0});
+
+    SourceModel *lhsModel = model.delegateModel<SourceModel>(lhs);
+    SourceModel *rhsModel = model.delegateModel<SourceModel>(rhs);
+    SinkModel *sinkModel = model.delegateModel<SinkModel>(sink);
+
+    lhsModel->setNumber(1.0);
+    rhsModel->setNumber(2.0);
+    lhsModel->setNumber(5.0);
+
+    CHECK(sinkModel->number() == 7.0);
+
+    int const computeCount = addModel->computeCount;
+    int const resultCount = addModel->resultCount;
+    std::size_t const hits = model.outputCache().hits();
+
+    // Inputs seen before: the delegate restores the cached result.
+    lhsModel->setNumber(1.0);
+
+    CHECK(addModel->computeCount == computeCount);
+    CHECK(addModel->resultCount - resultCount == 1);
+    CHECK(model.outputCache().hits() - hits == 1);
+    CHECK(sinkModel->number() == 3.0);
+
+    // A miss right after the hit must not combine the new operand with the
+    // one the delegate computed with last.
+    rhsModel->setNumber(10.0);
+
+    CHECK(addModel->computeCount - computeCount == 1);
+    CHECK(sinkModel->number() == 11.0);
+}
+
+TEST_CASE("Nodes without setComputeResult compute on a cache hit", "[memoization]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<ForgetfulAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+    model.setMemoizationBudget(1 << 20);
+
+    NodeId const lhs = model.addNode(SourceModel::Name());
+    NodeId const rhs = model.addNode(SourceModel::Name());
+    NodeId const add = model.addNode(ForgetfulAddModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    ForgetfulAddModel *addModel = model.delegateModel<ForgetfulAddModel>(add);
+
+    model.addConnection(ConnectionId{lhs, 0, add, 0});
+    model.addConnection(ConnectionId{rhs, 0, add, 1});
+    model.addConnection(ConnectionId{add, 0, sink, 0});
+
+    SourceModel *lhsModel = model.delegateModel<SourceModel>(lhs);
+    SinkModel *sinkModel = model.delegateModel<SinkModel>(sink);
+
+    lhsModel->setNumber(1.0);
+    model.delegateModel<SourceModel>(rhs)->setNumber(2.0);
+    lhsModel->setNumber(5.0);
+
+    int const computeCount = addModel->computeCount;
+
+    // The cached outputs would be dropped, the node computes them instead.
+    lhsModel->setNumber(1.0);
+
+    CHECK(addModel->resultCount == 1);
+    CHECK_FALSE(addModel->acceptsComputeResult());
+    CHECK(addModel->computeCount - computeCount == 1);
+    CHECK(sinkModel->number() == 3.0);
+
+    // No cache lookup any more.
+    lhsModel->setNumber(5.0);
+
+    CHECK(addModel->resultCount == 1);
+    CHECK(addModel->computeCount - computeCount == 2);
+    CHECK(sinkModel->number() == 7.0);
+}
+
+TEST_CASE("Self-emitted outputs drop the cached ones in every mode", "[memoization]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<MemoizedAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+    model.setMemoizationBudget(1 << 20);
+
+    BasicDiamond<MemoizedAddModel> diamond(model);
+
+    diamond.sourceModel()->setNumber(1.0);
+    diamond.sourceModel()->setNumber(2.0);
+
+    REQUIRE(model.outputCache().usedBytes() > 0);
+
+    model.setPropagationMode(GENERATE(PropagationMode::Topological, PropagationMode::Cascade));
+
+    diamond.addModel()->recompute();
+
+    CHECK(model.outputCache().usedBytes() == 0);
+}
+
+TEST_CASE("OutputCache drops the entries of one node only", "[memoization]")
+{
+    QtNodes::OutputCache cache;
+    cache.setBudget(1 << 20);
+
+    for (NodeId nodeId = 0; nodeId < 3; ++nodeId) {
+        for (std::uint64_t fingerprint = 1; fingerprint <= 50; ++fingerprint) {
+            cache.insert(nodeId, fingerprint, {{0, std::make_shared<NumberData>(1.0)}});
+        }
+    }
+
+    std::size_t const nodeBytes = cache.usedBytes() / 3;
+
+    cache.invalidateNode(1);
+
+    CHECK(cache.find(1, 7) == nullptr);
+    CHECK(cache.find(0, 7) != nullptr);
+    CHECK(cache.find(2, 50) != nullptr);
+    CHECK(cache.usedBytes() == 2 * nodeBytes);
+
+    SECTION("evicted entries leave the node index")
+    {
+        cache.setBudget(nodeBytes);
+
+        cache.invalidateNode(0);
+        cache.invalidateNode(2);
+
+        CHECK(cache.usedBytes() == 0);
+    }
+}
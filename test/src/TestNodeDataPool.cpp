@@ -0,0 +1,133 @@
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/NodeDataPool>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <thread>
+#include <utility>
+
+using QtNodes::NodeDataPool;
+
+namespace {
+
+/// Larger than NumberData, so its shared blocks are too.
+class SamplesData : public QtNodes::NodeData
+{
+public:
+    QtNodes::NodeDataType type() const override { return NumberData().type(); }
+
+    double samples[64] = {};
+};
+
+} // namespace
+
+TEST_CASE("NodeDataPool reuses the released blocks", "[pool]")
+{
+    using Pool = NodeDataPool<NumberData>;
+
+    Pool::clear();
+
+    auto first = Pool::make(1.0);
+
+    CHECK(Pool::misses() == 1);
+    CHECK(Pool::hits() == 0);
+
+    NumberData const *const block = first.get();
+
+    first.reset();
+
+    auto second = Pool::make(2.0);
+
+    CHECK(second.get() == block);
+    CHECK(second->number() == 2.0);
+    CHECK(Pool::hits() == 1);
+
+    // The only free block is in use.
+    auto third = Pool::make(3.0);
+
+    CHECK(Pool::misses() == 2);
+    CHECK(Pool::hitRate() == Approx(1.0 / 3.0));
+
+    SECTION("up to the capacity")
+    {
+        Pool::setCapacity(1);
+
+        second.reset();
+        third.reset();
+
+        auto reused = Pool::make(4.0);
+        auto allocated = Pool::make(5.0);
+
+        CHECK(Pool::hits() == 2);
+        CHECK(Pool::misses() == 3);
+
+        Pool::setCapacity(1024);
+    }
+
+    Pool::clear();
+}
+
+TEST_CASE("NodeDataPool takes back the blocks released on other threads", "[pool]")
+{
+    using Pool = NodeDataPool<NumberData>;
+
+    Pool::clear();
+
+    auto data = Pool::make(1.0);
+
+    NumberData const *const block = data.get();
+
+    // The last reference goes away on the worker.
+    std::thread worker([payload = std::move(data)]() mutable { payload.reset(); });
+    worker.join();
+
+    auto reused = Pool::make(2.0);
+
+    CHECK(reused.get() == block);
+    CHECK(Pool::hits() == 1);
+    CHECK(Pool::misses() == 1);
+
+    // And the other way round.
+    std::shared_ptr<NumberData> made;
+
+    std::thread maker([&made]() { made = Pool::make(3.0); });
+    maker.join();
+
+    made.reset();
+
+    CHECK(Pool::make(4.0) != nullptr);
+    CHECK(Pool::hits() == 2);
+
+    Pool::clear();
+}
+
+TEST_CASE("NodeDataPool keeps the blocks of each type apart", "[pool]")
+{
+    using NumberPool = NodeDataPool<NumberData>;
+    using SamplesPool = NodeDataPool<SamplesData>;
+
+    NumberPool::clear();
+    SamplesPool::clear();
+
+    NumberPool::make(1.0).reset();
+    SamplesPool::make().reset();
+
+    // Each type gets back its own block, of its own size.
+    auto samples = SamplesPool::make();
+    auto number = NumberPool::make(2.0);
+
+    CHECK(samples->samples[0] == 0.0);
+    CHECK(number->number() == 2.0);
+    CHECK(SamplesPool::hits() == 1);
+    CHECK(SamplesPool::misses() == 1);
+    CHECK(NumberPool::hits() == 1);
+    CHECK(NumberPool::misses() == 1);
+
+    samples.reset();
+    number.reset();
+
+    NumberPool::clear();
+    SamplesPool::clear();
+}
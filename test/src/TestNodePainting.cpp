@@ -0,0 +1,149 @@
+#include "ApplicationSetup.hpp"
+#include "NodeGraphicsObject.hpp"
+#include "StubGraphs.hpp"
+
+#include <QtNodes/DataFlowGraphicsScene>
+
+#include <catch2/catch.hpp>
+
+#include <QGraphicsDropShadowEffect>
+#include <QImage>
+#include <QPainter>
+
+using QtNodes::DataFlowGraphicsScene;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeGraphicsObject;
+using QtNodes::NodeId;
+using QtNodes::NodeRole;
+using QtNodes::NodeStyle;
+using QtNodes::PortIndex;
+using QtNodes::PortRole;
+using QtNodes::PortType;
+
+namespace {
+
+/// Counts the QVariant queries and the style lookups made by the scene.
+class CountingGraphModel : public DataFlowGraphModel
+{
+public:
+    using DataFlowGraphModel::DataFlowGraphModel;
+
+    QVariant nodeData(NodeId nodeId, NodeRole role) const override
+    {
+        ++variantQueries;
+        return DataFlowGraphModel::nodeData(nodeId, role);
+    }
+
+    QVariant portData(NodeId nodeId,
+                      PortType portType,
+                      PortIndex portIndex,
+                      PortRole role) const override
+    {
+        ++variantQueries;
+        return DataFlowGraphModel::portData(nodeId, portType, portIndex, role);
+    }
+
+    NodeStyle nodeStyle(NodeId const nodeId) const override
+    {
+        ++styleQueries;
+        return DataFlowGraphModel::nodeStyle(nodeId);
+    }
+
+    mutable int variantQueries = 0;
+    mutable int styleQueries = 0;
+};
+
+void render(DataFlowGraphicsScene &scene)
+{
+    QImage image(640, 480, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    scene.render(&painter);
+}
+
+QGraphicsDropShadowEffect *shadowOf(NodeGraphicsObject *node)
+{
+    return qobject_cast<QGraphicsDropShadowEffect *>(node->graphicsEffect());
+}
+
+} // namespace
+
+TEST_CASE("Painting the scene uses the typed accessors", "[gui]")
+{
+    auto setup = applicationSetup();
+
+    CountingGraphModel model(stubRegistry());
+
+    Diamond diamond(model);
+
+    DataFlowGraphicsScene scene(model);
+
+    render(scene);
+
+    model.variantQueries = 0;
+    model.styleQueries = 0;
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    render(scene);
+
+    CHECK(model.variantQueries == 0);
+
+    // The style is cached by the graphics objects, new data does not change it.
+    CHECK(model.styleQueries == 0);
+}
+
+TEST_CASE("The node shadow is updated in place", "[gui]")
+{
+    auto setup = applicationSetup();
+
+    CountingGraphModel model(stubRegistry());
+
+    Diamond diamond(model);
+
+    DataFlowGraphicsScene scene(model);
+
+    NodeGraphicsObject *node = scene.nodeGraphicsObject(diamond.add);
+
+    REQUIRE(node);
+
+    QGraphicsDropShadowEffect *effect = shadowOf(node);
+
+    REQUIRE(effect);
+
+    SECTION("new data keeps the effect")
+    {
+        diamond.sourceModel()->setNumber(3.0);
+
+        render(scene);
+
+        CHECK(shadowOf(node) == effect);
+    }
+
+    SECTION("a style change recolours the effect")
+    {
+        NodeStyle style = diamond.addModel()->nodeStyle();
+        style.ShadowColor = QColor(12, 34, 56);
+
+        model.styleQueries = 0;
+
+        diamond.addModel()->setNodeStyle(style);
+
+        CHECK(model.styleQueries == 1);
+        CHECK(node->nodeStyle().ShadowColor == QColor(12, 34, 56));
+
+        REQUIRE(shadowOf(node) == effect);
+        CHECK(effect->color() == QColor(12, 34, 56));
+    }
+
+    SECTION("disabling the shadow removes the effect")
+    {
+        NodeStyle style = diamond.addModel()->nodeStyle();
+        style.ShadowEnabled = false;
+
+        diamond.addModel()->setNodeStyle(style);
+
+        CHECK(shadowOf(node) == nullptr);
+    }
+}
@@ -0,0 +1,134 @@
+#include "ApplicationSetup.hpp"
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+
+#include "NodeSlotMap.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include <memory>
+#include <stdexcept>
+
+using QtNodes::DataFlowGraphModel;
+using QtNodes::InvalidNodeId;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+using QtNodes::NodeSlotMap;
+
+TEST_CASE("NodeSlotMap stores small and large ids", "[storage]")
+{
+    NodeSlotMap<int> map;
+
+    NodeId const large = 4000000000u;
+
+    map.insert(1, 10);
+    map.insert(large, 20);
+    map.insert(InvalidNodeId - 1, 30);
+
+    CHECK(map.size() == 3);
+    CHECK(*map.find(1) == 10);
+    CHECK(*map.find(large) == 20);
+    CHECK(*map.find(InvalidNodeId - 1) == 30);
+    CHECK(map.find(2) == nullptr);
+
+    SECTION("erasing moves the last record")
+    {
+        CHECK(map.erase(1));
+        CHECK_FALSE(map.contains(1));
+        CHECK(*map.find(large) == 20);
+        CHECK(*map.find(InvalidNodeId - 1) == 30);
+
+        CHECK(map.erase(large));
+        CHECK_FALSE(map.contains(large));
+        CHECK(*map.find(InvalidNodeId - 1) == 30);
+        CHECK(map.size() == 1);
+    }
+
+    SECTION("inserting an existing id replaces the record")
+    {
+        map.insert(large, 21);
+
+        CHECK(map.size() == 3);
+        CHECK(*map.find(large) == 21);
+    }
+}
+
+TEST_CASE("NodeSlotMap handles expire with the record", "[storage]")
+{
+    NodeSlotMap<int> map;
+
+    NodeId const id = GENERATE(NodeId(7), NodeId(4000000000u));
+
+    map.insert(id, 10);
+
+    auto const handle = map.handle(id);
+
+    CHECK(map.isValid(handle));
+
+    SECTION("replacing the record keeps the handle")
+    {
+        map.insert(id, 11);
+
+        CHECK(map.isValid(handle));
+    }
+
+    SECTION("restoring an erased id does not revive the handle")
+    {
+        map.erase(id);
+
+        CHECK_FALSE(map.isValid(handle));
+
+        map.insert(id, 12);
+
+        CHECK_FALSE(map.isValid(handle));
+        CHECK(map.isValid(map.handle(id)));
+    }
+
+    SECTION("an unknown id has no valid handle")
+    {
+        CHECK_FALSE(map.isValid(map.handle(id + 1)));
+    }
+}
+
+TEST_CASE("DataFlowGraphModel validates the loaded node ids", "[storage]")
+{
+    auto setup = applicationSetup();
+
+    auto registry = std::make_shared<NodeDelegateModelRegistry>();
+    registry->registerModel<SourceModel>();
+
+    DataFlowGraphModel model(registry);
+
+    auto nodeJson = [](double const id) {
+        QJsonObject internalData;
+        internalData["model-name"] = SourceModel::Name();
+
+        QJsonObject json;
+        json["id"] = id;
+        json["internal-data"] = internalData;
+
+        return json;
+    };
+
+    SECTION("a large id is accepted")
+    {
+        model.loadNode(nodeJson(4000000000.0));
+
+        CHECK(model.nodeExists(4000000000u));
+    }
+
+    SECTION("negative, fractional and reserved ids are rejected")
+    {
+        CHECK_THROWS_AS(model.loadNode(nodeJson(-1.0)), std::logic_error);
+        CHECK_THROWS_AS(model.loadNode(nodeJson(1.5)), std::logic_error);
+        CHECK_THROWS_AS(model.loadNode(nodeJson(static_cast<double>(InvalidNodeId))),
+                        std::logic_error);
+
+        CHECK(model.allNodeIds().empty());
+    }
+}
@@ -0,0 +1,77 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using QtNodes::DataFlowGraphModel;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Cascade is the default propagation mode", "[propagation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+
+    CHECK(model.propagationMode() == PropagationMode::Cascade);
+
+    Diamond diamond(model);
+
+    int const computeCount = diamond.addModel()->computeCount;
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    // One computation per changed operand, the first one with a stale operand.
+    CHECK(diamond.addModel()->computeCount - computeCount == 2);
+    CHECK(diamond.sinkModel()->number() == 4.0);
+}
+
+TEST_CASE("Cascade still delivers the intermediate results", "[propagation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+
+    Diamond diamond(model);
+
+    diamond.sourceModel()->setNumber(1.0);
+    diamond.sourceModel()->setNumber(2.0);
+
+    // 3 is the sum of the new and the stale operand, the glitch the
+    // topological modes avoid.
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{2.0, 3.0, 4.0});
+
+    SECTION("unlike the topological propagation")
+    {
+        DataFlowGraphModel topological(stubRegistry());
+        topological.setPropagationMode(PropagationMode::Topological);
+
+        Diamond other(topological);
+
+        other.sourceModel()->setNumber(1.0);
+        other.sourceModel()->setNumber(2.0);
+
+        CHECK(other.sinkModel()->numbers() == std::vector<double>{2.0, 4.0});
+    }
+}
+
+TEST_CASE("Topological propagation computes every node once per wave", "[propagation]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    Diamond diamond(model);
+
+    int const computeCount = diamond.addModel()->computeCount;
+    std::size_t const received = diamond.sinkModel()->received.size();
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    CHECK(diamond.addModel()->computeCount - computeCount == 1);
+    CHECK(diamond.sinkModel()->received.size() - received == 1);
+    CHECK(diamond.sinkModel()->number() == 4.0);
+}
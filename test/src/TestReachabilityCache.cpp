@@ -0,0 +1,99 @@
+#include "ReachabilityCache.hpp"
+#include "TopologicalOrder.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <unordered_set>
+
+using QtNodes::NodeId;
+using QtNodes::ReachabilityCache;
+using QtNodes::TopologicalOrder;
+
+using Direction = ReachabilityCache::Direction;
+
+TEST_CASE("ReachabilityCache answers and invalidates queries", "[topology]")
+{
+    TopologicalOrder graph;
+    ReachabilityCache cache(graph);
+
+    // 1 -> 2 -> 3, with a huge id at the end of the chain.
+    NodeId const large = 4000000000u;
+
+    for (NodeId nodeId : {NodeId(1), NodeId(2), NodeId(3), large}) {
+        graph.addNode(nodeId);
+    }
+
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 3);
+    graph.addEdge(3, large);
+
+    CHECK(cache.reachable(1, Direction::Downstream)
+          == std::unordered_set<NodeId>{2, 3, large});
+    CHECK(cache.reachable(1, Direction::Downstream, 1) == std::unordered_set<NodeId>{2});
+    CHECK(cache.reachable(large, Direction::Upstream) == std::unordered_set<NodeId>{1, 2, 3});
+    CHECK(cache.contains(1, Direction::Downstream, large));
+    CHECK_FALSE(cache.contains(large, Direction::Downstream, 1));
+
+    SECTION("a removed edge drops the affected results")
+    {
+        graph.removeEdge(2, 3);
+        cache.invalidateEdge(2, 3);
+
+        CHECK(cache.reachable(1, Direction::Downstream) == std::unordered_set<NodeId>{2});
+        CHECK(cache.reachable(large, Direction::Upstream) == std::unordered_set<NodeId>{3});
+    }
+
+    SECTION("a removed node releases its slot")
+    {
+        graph.removeNode(2);
+        cache.invalidateNode(2);
+
+        graph.addNode(5);
+        graph.addEdge(1, 5);
+        cache.invalidateEdge(1, 5);
+
+        CHECK(cache.reachable(1, Direction::Downstream) == std::unordered_set<NodeId>{5});
+        CHECK(cache.reachable(large, Direction::Upstream) == std::unordered_set<NodeId>{3});
+    }
+
+    SECTION("the least recently used results are evicted")
+    {
+        cache.setCapacity(2);
+
+        CHECK(cache.size() == 2);
+
+        cache.reachable(2, Direction::Downstream);
+        cache.reachable(3, Direction::Downstream);
+        cache.reachable(2, Direction::Downstream);
+
+        CHECK(cache.size() == 2);
+        CHECK(cache.reachable(3, Direction::Upstream) == std::unordered_set<NodeId>{1, 2});
+        CHECK(cache.size() == 2);
+    }
+}
+
+TEST_CASE("ReachabilityCache merges the results into one set", "[topology]")
+{
+    TopologicalOrder graph;
+    ReachabilityCache cache(graph);
+
+    // 1 -> 2 -> 3 and 4 -> 5, 6 stands alone.
+    for (NodeId nodeId = 1; nodeId <= 6; ++nodeId) {
+        graph.addNode(nodeId);
+    }
+
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 3);
+    graph.addEdge(4, 5);
+
+    QtNodes::NodeBitSet upstream;
+
+    cache.collect(3, Direction::Upstream, upstream);
+    cache.collect(5, Direction::Upstream, upstream);
+
+    for (NodeId nodeId = 1; nodeId <= 5; ++nodeId) {
+        CHECK(cache.contains(upstream, nodeId));
+    }
+
+    CHECK_FALSE(cache.contains(upstream, 6));
+}
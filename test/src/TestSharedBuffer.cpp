@@ -0,0 +1,149 @@
+#include "ApplicationSetup.hpp"
+#include "StubDelegateModels.hpp"
+
+#include <QtNodes/DataFlowGraphModel>
+#include <QtNodes/NodeDelegateModelRegistry>
+#include <QtNodes/SharedBuffer>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+using QtNodes::BufferData;
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeDelegateModelRegistry;
+using QtNodes::NodeId;
+using QtNodes::SharedBuffer;
+
+namespace {
+
+class ColumnData : public BufferData<double>
+{
+public:
+    explicit ColumnData(std::size_t const size)
+        : BufferData(Buffer(size))
+    {}
+
+    explicit ColumnData(Buffer buffer)
+        : BufferData(std::move(buffer))
+    {}
+
+    QtNodes::NodeDataType type() const override { return NumberData().type(); }
+
+    double *mutableData() { return _buffer.mutableData(); }
+};
+
+/// Fills one column in place and emits the same data object every time.
+class ColumnSourceModel : public QtNodes::NodeDelegateModel
+{
+public:
+    static QString Name() { return QStringLiteral("ColumnSource"); }
+
+    QString name() const override { return Name(); }
+
+    QString caption() const override { return Name(); }
+
+    unsigned int nPorts(QtNodes::PortType const portType) const override
+    {
+        return portType == QtNodes::PortType::Out ? 1 : 0;
+    }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return NumberData().type();
+    }
+
+    void setInData(std::shared_ptr<QtNodes::NodeData>, QtNodes::PortIndex const) override {}
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override
+    {
+        return _column;
+    }
+
+    QWidget *embeddedWidget() override { return nullptr; }
+
+    void fill(double const value)
+    {
+        _column->mutableData()[0] = value;
+
+        Q_EMIT dataUpdated(0);
+    }
+
+    void emitAgain() { Q_EMIT dataUpdated(0); }
+
+private:
+    std::shared_ptr<ColumnData> _column = std::make_shared<ColumnData>(1);
+};
+
+} // namespace
+
+TEST_CASE("SharedBuffer copies on write", "[buffer]")
+{
+    SharedBuffer<double> original(4, 1.0);
+    SharedBuffer<double> copy = original;
+
+    CHECK(original.isShared());
+    CHECK(copy.sharesStorageWith(original));
+
+    std::uint64_t const generation = original.generation();
+
+    copy.mutableData()[0] = 2.0;
+
+    CHECK_FALSE(original.isShared());
+    CHECK_FALSE(copy.sharesStorageWith(original));
+    CHECK(original[0] == 1.0);
+    CHECK(copy[0] == 2.0);
+    CHECK(original.generation() == generation);
+    CHECK(copy.generation() != generation);
+}
+
+TEST_CASE("Buffer data modified in place gets a new revision", "[buffer]")
+{
+    ColumnData column(4);
+
+    ColumnData const shared(column.buffer());
+
+    CHECK(column.equals(shared));
+
+    std::uint64_t const revision = column.revision();
+
+    column.mutableData()[0] = 1.0;
+
+    CHECK(column.revision() != revision);
+    CHECK_FALSE(column.equals(shared));
+}
+
+TEST_CASE("A buffer modified in place passes the cutoff", "[buffer]")
+{
+    auto setup = applicationSetup();
+
+    auto registry = std::make_shared<NodeDelegateModelRegistry>();
+    registry->registerModel<ColumnSourceModel>();
+    registry->registerModel<SinkModel>();
+
+    DataFlowGraphModel model(registry);
+    model.setPropagationMode(DataFlowGraphModel::PropagationMode::Topological);
+
+    NodeId const source = model.addNode(ColumnSourceModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    model.addConnection(ConnectionId{source, 0, sink, 0});
+
+    ColumnSourceModel *sourceModel = model.delegateModel<ColumnSourceModel>(source);
+    SinkModel *sinkModel = model.delegateModel<SinkModel>(sink);
+
+    sinkModel->received.clear();
+
+    sourceModel->fill(1.0);
+    sourceModel->fill(2.0);
+
+    CHECK(sinkModel->received.size() == 2);
+
+    // Nothing was modified since the last update.
+    sourceModel->emitAgain();
+
+    CHECK(sinkModel->received.size() == 2);
+}
@@ -0,0 +1,73 @@
+#include "ApplicationSetup.hpp"
+#include "AsyncAddModel.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Streaming delivers every update in order", "[streaming]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Streaming);
+
+    Diamond diamond(model);
+
+    for (double number : {1.0, 2.0, 2.0, 3.0}) {
+        diamond.sourceModel()->setNumber(number);
+    }
+
+    // Repeated values are updates of their own in a stream.
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{2.0, 4.0, 4.0, 6.0});
+    CHECK(model.queueDepth(ConnectionId{diamond.add, 0, diamond.sink, 0}) == 0);
+}
+
+TEST_CASE("Full queues throttle the sources", "[streaming]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<AsyncAddModel>());
+    model.setPropagationMode(PropagationMode::Streaming);
+    model.setStreamQueueCapacity(2);
+
+    BasicDiamond<AsyncAddModel> diamond(model);
+
+    // The new connections hand the empty source output to the node.
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    AsyncAddModel *add = diamond.addModel();
+    add->hold = true;
+
+    std::vector<bool> throttling;
+
+    QObject::connect(diamond.sourceModel(),
+                     &QtNodes::NodeDelegateModel::backpressureChanged,
+                     [&](bool const throttled) { throttling.push_back(throttled); });
+
+    // The first update keeps the node busy, the next ones fill the queues.
+    for (double number : {1.0, 2.0, 3.0}) {
+        diamond.sourceModel()->setNumber(number);
+    }
+
+    CHECK(model.isComputing(diamond.add));
+    CHECK(model.queueDepth(ConnectionId{diamond.source, 0, diamond.add, 0}) == 2);
+    CHECK(model.isThrottled(diamond.source));
+    CHECK(throttling == std::vector<bool>{true});
+
+    add->hold = false;
+
+    REQUIRE(waitUntil([&]() { return diamond.sinkModel()->numbers().size() == 3; }));
+
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{2.0, 4.0, 6.0});
+    CHECK_FALSE(model.isThrottled(diamond.source));
+    CHECK(throttling == std::vector<bool>{true, false});
+}
@@ -0,0 +1,188 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::DataTypeId;
+using QtNodes::ExecutionPlan;
+using QtNodes::NodeDataType;
+using QtNodes::NodeId;
+using QtNodes::SharedNodeData;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+namespace {
+
+/// A second data type, only connectable to numbers through a converter.
+class TextData : public QtNodes::NodeData
+{
+public:
+    explicit TextData(QString text = QString())
+        : _text(std::move(text))
+    {}
+
+    QtNodes::NodeDataType type() const override
+    {
+        return {QStringLiteral("text"), QStringLiteral("Text")};
+    }
+
+    QString const &text() const { return _text; }
+
+private:
+    QString _text;
+};
+
+/// Emits text, feeds the number ports through a converter.
+class TextSourceModel : public SourceModel
+{
+public:
+    static QString Name() { return QStringLiteral("TextSource"); }
+
+    QString name() const override { return Name(); }
+
+    QtNodes::NodeDataType dataType(QtNodes::PortType, QtNodes::PortIndex) const override
+    {
+        return TextData().type();
+    }
+
+    std::shared_ptr<QtNodes::NodeData> outData(QtNodes::PortIndex const) override { return _text; }
+
+    void setText(QString text)
+    {
+        _text = std::make_shared<TextData>(std::move(text));
+
+        Q_EMIT dataUpdated(0);
+    }
+
+private:
+    std::shared_ptr<TextData> _text;
+};
+
+SharedNodeData textToNumber(SharedNodeData nodeData)
+{
+    auto text = std::static_pointer_cast<TextData>(nodeData);
+
+    return std::make_shared<NumberData>(text->text().toDouble());
+}
+
+} // namespace
+
+TEST_CASE("Registering a converter again reuses its slot", "[converters]")
+{
+    auto registry = stubRegistry();
+
+    NodeDataType const text = TextData().type();
+    NodeDataType const number = NumberData().type();
+    NodeDataType const other{QStringLiteral("other"), QStringLiteral("Other")};
+
+    registry->registerTypeConverter({text, number}, textToNumber);
+    registry->registerTypeConverter({other, number}, textToNumber);
+    registry->registerTypeConverter({text, number}, textToNumber);
+
+    CHECK(registry->typeConverterCount() == 2);
+
+    // Clearing the first converter must keep the second one reachable.
+    registry->registerTypeConverter({text, number}, {});
+
+    CHECK(registry->typeConverterCount() == 1);
+    CHECK_FALSE(registry->getTypeConverter(text, number));
+    CHECK(registry->getTypeConverter(other, number));
+    CHECK(registry->dataTypesCompatible(registry->dataTypeId(text), registry->dataTypeId(number)));
+
+    registry->registerTypeConverter({other, number}, {});
+    registry->registerTypeConverter({text, number}, textToNumber);
+
+    CHECK(registry->typeConverterCount() == 1);
+    CHECK(registry->getTypeConverter(text, number));
+    CHECK_FALSE(registry->getTypeConverter(other, number));
+    CHECK(registry->dataTypesCompatible(registry->dataTypeId(other), registry->dataTypeId(number)));
+}
+
+TEST_CASE("The type table keeps its cells while growing", "[converters]")
+{
+    auto registry = stubRegistry();
+
+    NodeDataType const text = TextData().type();
+    NodeDataType const number = NumberData().type();
+
+    registry->registerTypeConverter({text, number}, textToNumber);
+
+    DataTypeId const textId = registry->dataTypeId(text);
+    DataTypeId const numberId = registry->dataTypeId(number);
+
+    std::vector<DataTypeId> added;
+
+    for (int i = 0; i < 40; ++i) {
+        added.push_back(registry->dataTypeId(QStringLiteral("type%1").arg(i)));
+    }
+
+    CHECK(registry->typeConverter(textId, numberId) != nullptr);
+    CHECK_FALSE(registry->dataTypesCompatible(numberId, textId));
+
+    for (DataTypeId const id : added) {
+        CHECK(registry->dataTypesCompatible(id, id));
+        CHECK_FALSE(registry->dataTypesCompatible(id, numberId));
+        CHECK_FALSE(registry->dataTypesCompatible(textId, id));
+    }
+}
+
+TEST_CASE("Connections convert the data between port types", "[converters]")
+{
+    auto setup = applicationSetup();
+
+    auto registry = stubRegistry<TextSourceModel>();
+
+    DataFlowGraphModel model(registry);
+
+    NodeId const source = model.addNode(TextSourceModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    ConnectionId const connectionId{source, 0, sink, 0};
+
+    CHECK_FALSE(model.connectionPossible(connectionId));
+
+    registry->registerTypeConverter({TextData().type(), NumberData().type()}, textToNumber);
+
+    REQUIRE(model.connectionPossible(connectionId));
+
+    auto mode = GENERATE(PropagationMode::Cascade, PropagationMode::Topological);
+
+    model.setPropagationMode(mode);
+    model.addConnection(connectionId);
+
+    TextSourceModel *sourceModel = model.delegateModel<TextSourceModel>(source);
+    SinkModel *sinkModel = model.delegateModel<SinkModel>(sink);
+
+    sourceModel->setText(QStringLiteral("2.5"));
+
+    CHECK(sinkModel->number() == 2.5);
+
+    SECTION("a new connection converts the current output")
+    {
+        NodeId const late = model.addNode(SinkModel::Name());
+
+        model.addConnection(ConnectionId{source, 0, late, 0});
+
+        CHECK(model.delegateModel<SinkModel>(late)->number() == 2.5);
+    }
+
+    SECTION("a compiled plan converts as well")
+    {
+        ExecutionPlan const plan = model.compile();
+
+        ExecutionPlan::Slots slots;
+
+        REQUIRE(model.execute(plan,
+                              {{plan.outputSlot(source, 0),
+                                std::make_shared<TextData>(QStringLiteral("7"))}},
+                              slots));
+
+        CHECK(sinkModel->number() == 7.0);
+    }
+}
@@ -0,0 +1,34 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+
+#include <catch2/catch.hpp>
+
+using QtNodes::DataFlowGraphModel;
+
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+TEST_CASE("Unchanged outputs stop the propagation", "[cutoff]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry());
+    model.setPropagationMode(PropagationMode::Topological);
+
+    Diamond diamond(model);
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    int const computeCount = diamond.addModel()->computeCount;
+    std::size_t const received = diamond.sinkModel()->received.size();
+
+    // A new but equal payload.
+    diamond.sourceModel()->setNumber(2.0);
+
+    CHECK(diamond.addModel()->computeCount == computeCount);
+    CHECK(diamond.sinkModel()->received.size() == received);
+
+    diamond.sourceModel()->setNumber(3.0);
+
+    CHECK(diamond.addModel()->computeCount - computeCount == 1);
+    CHECK(diamond.sinkModel()->number() == 6.0);
+}
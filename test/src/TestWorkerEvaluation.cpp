@@ -0,0 +1,91 @@
+#include "ApplicationSetup.hpp"
+#include "StubGraphs.hpp"
+#include "WaitUntil.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QThread>
+
+#include <vector>
+
+using QtNodes::ConnectionId;
+using QtNodes::DataFlowGraphModel;
+using QtNodes::NodeId;
+
+using ExecutionAffinity = QtNodes::NodeDelegateModel::ExecutionAffinity;
+using PropagationMode = DataFlowGraphModel::PropagationMode;
+
+namespace {
+
+/// Add node the model may compute on any thread.
+class ThreadSafeAddModel : public AddModel
+{
+public:
+    static QString Name() { return QStringLiteral("ThreadSafeAdd"); }
+
+    QString name() const override { return Name(); }
+
+    ExecutionAffinity affinity() const override { return ExecutionAffinity::AnyThread; }
+};
+
+} // namespace
+
+TEST_CASE("Thread-safe nodes compute on the worker pool", "[workers]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<ThreadSafeAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+    model.setWorkerThreadCount(2);
+
+    BasicDiamond<ThreadSafeAddModel> diamond(model);
+
+    int const computeCount = diamond.addModel()->computeCount;
+
+    diamond.sourceModel()->setNumber(2.0);
+
+    CHECK(model.isComputing(diamond.add));
+
+    REQUIRE(waitUntil([&]() { return !model.isComputing(diamond.add); }));
+
+    CHECK(diamond.addModel()->computeCount - computeCount == 1);
+    CHECK(diamond.addModel()->computeThread != QThread::currentThread());
+    CHECK(diamond.sinkModel()->numbers() == std::vector<double>{4.0});
+}
+
+TEST_CASE("Independent branches compute in parallel, each node once", "[workers]")
+{
+    auto setup = applicationSetup();
+
+    DataFlowGraphModel model(stubRegistry<ThreadSafeAddModel>());
+    model.setPropagationMode(PropagationMode::Topological);
+    model.setWorkerThreadCount(4);
+
+    NodeId const source = model.addNode(SourceModel::Name());
+    NodeId const sink = model.addNode(SinkModel::Name());
+
+    // source -> left, right -> join -> sink
+    NodeId const left = model.addNode(ThreadSafeAddModel::Name());
+    NodeId const right = model.addNode(ThreadSafeAddModel::Name());
+    NodeId const join = model.addNode(ThreadSafeAddModel::Name());
+
+    for (NodeId const branch : {left, right}) {
+        model.addConnection(ConnectionId{source, 0, branch, 0});
+        model.addConnection(ConnectionId{source, 0, branch, 1});
+    }
+
+    model.addConnection(ConnectionId{left, 0, join, 0});
+    model.addConnection(ConnectionId{right, 0, join, 1});
+    model.addConnection(ConnectionId{join, 0, sink, 0});
+
+    int const joinCount = model.delegateModel<AddModel>(join)->computeCount;
+
+    model.delegateModel<SourceModel>(source)->setNumber(1.0);
+
+    REQUIRE(waitUntil([&]() {
+        return !model.isComputing(left) && !model.isComputing(right) && !model.isComputing(join);
+    }));
+
+    CHECK(model.delegateModel<AddModel>(join)->computeCount - joinCount == 1);
+    CHECK(model.delegateModel<SinkModel>(sink)->numbers() == std::vector<double>{4.0});
+}